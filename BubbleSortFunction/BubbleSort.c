@@ -1,16 +1,32 @@
 #include "BubbleSort.h"
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PDQ_INSERTION_THRESHOLD 24 ///< Ranges shorter than this are finished with insertion sort
+#define PDQ_NINTHER_THRESHOLD 128 ///< Ranges longer than this use Tukey's ninther as pivot
+#define PDQ_PARTIAL_INSERTION_LIMIT 8 ///< Element moves allowed before a partial insertion sort gives up
 
 /**
- * @brief Swaps two elements in memory, each of size 'wide' bytes.
- *
- * This function takes two pointers, 'a' and 'b', and swaps the content of
- * the memory they point to, assuming that each element occupies 'wide' bytes.
+ * @brief Per-call sort state shared by the internal sorting routines.
+ */
+typedef struct {
+    size_t wide; ///< Size (in bytes) of each element
+    int (*cmp)(void* a, void* b); ///< User comparison function
+    SwapFunc swapElems; ///< Swap kernel selected once for 'wide'
+} SortEnv;
+
+#define SWAP_BLOCK_THRESHOLD 64 ///< Records at least this wide are swapped in SWAP_BLOCK_SIZE chunks
+#define SWAP_BLOCK_SIZE 32 ///< Chunk size moved per step by the block swap kernel
+
+/**
+ * @brief Swaps two elements one byte at a time.
  *
- * @param a Pointer to the first element to be swapped.
- * @param b Pointer to the second element to be swapped.
- * @param wide Size (in bytes) of each element.
+ * Fallback kernel for element widths that no specialized kernel covers.
  */
-void swap(char* a, char* b, int wide) {
+static void SwapBytes(char* a, char* b, int wide) {
     char temp;
     for (int i = 0; i < wide; i++) {
         temp = *a;
@@ -21,6 +37,163 @@ void swap(char* a, char* b, int wide) {
     }
 }
 
+/**
+ * @brief Swaps two 4-byte elements with a single load/store per side.
+ */
+static void Swap4(char* a, char* b, int wide) {
+    uint32_t x, y;
+    (void)wide;
+    memcpy(&x, a, 4);
+    memcpy(&y, b, 4);
+    memcpy(a, &y, 4);
+    memcpy(b, &x, 4);
+}
+
+/**
+ * @brief Swaps two 8-byte elements with a single load/store per side.
+ */
+static void Swap8(char* a, char* b, int wide) {
+    uint64_t x, y;
+    (void)wide;
+    memcpy(&x, a, 8);
+    memcpy(&y, b, 8);
+    memcpy(a, &y, 8);
+    memcpy(b, &x, 8);
+}
+
+/**
+ * @brief Swaps two 16-byte elements.
+ */
+static void Swap16(char* a, char* b, int wide) {
+    uint64_t x[2], y[2];
+    (void)wide;
+    memcpy(x, a, 16);
+    memcpy(y, b, 16);
+    memcpy(a, y, 16);
+    memcpy(b, x, 16);
+}
+
+/**
+ * @brief Swaps two elements whose width is a multiple of 4 bytes, one 32-bit word at a time.
+ */
+static void SwapInts(char* a, char* b, int wide) {
+    uint32_t x, y;
+    for (int i = 0; i < wide; i += 4) {
+        memcpy(&x, a + i, 4);
+        memcpy(&y, b + i, 4);
+        memcpy(a + i, &y, 4);
+        memcpy(b + i, &x, 4);
+    }
+}
+
+/**
+ * @brief Swaps two elements whose width is a multiple of 8 bytes, one machine word at a time.
+ */
+static void SwapWords(char* a, char* b, int wide) {
+    uint64_t x, y;
+    for (int i = 0; i < wide; i += 8) {
+        memcpy(&x, a + i, 8);
+        memcpy(&y, b + i, 8);
+        memcpy(a + i, &y, 8);
+        memcpy(b + i, &x, 8);
+    }
+}
+
+/**
+ * @brief Swaps two large elements in SWAP_BLOCK_SIZE-byte chunks.
+ *
+ * Each chunk is staged through fixed-size buffers, which compilers lower to
+ * SIMD-width loads and stores. The remaining tail is swapped by word, then by byte.
+ */
+static void SwapBlock(char* a, char* b, int wide) {
+    char x[SWAP_BLOCK_SIZE], y[SWAP_BLOCK_SIZE];
+    int i = 0;
+    for (; i + SWAP_BLOCK_SIZE <= wide; i += SWAP_BLOCK_SIZE) {
+        memcpy(x, a + i, SWAP_BLOCK_SIZE);
+        memcpy(y, b + i, SWAP_BLOCK_SIZE);
+        memcpy(a + i, y, SWAP_BLOCK_SIZE);
+        memcpy(b + i, x, SWAP_BLOCK_SIZE);
+    }
+    int words = (wide - i) & ~7;
+    SwapWords(a + i, b + i, words);
+    i += words;
+    SwapBytes(a + i, b + i, wide - i);
+}
+
+/**
+ * @brief Maps an element width to its specialized swap kernel.
+ */
+static SwapFunc SelectSwapKernel(int wide) {
+    switch (wide) {
+    case 4:
+        return Swap4;
+    case 8:
+        return Swap8;
+    case 16:
+        return Swap16;
+    default:
+        break;
+    }
+    if (wide >= SWAP_BLOCK_THRESHOLD) {
+        return SwapBlock;
+    }
+    if (wide % 8 == 0) {
+        return SwapWords;
+    }
+    if (wide % 4 == 0) {
+        return SwapInts;
+    }
+    return SwapBytes;
+}
+
+#ifdef SORT_STATS
+_Atomic unsigned long long SortSwapCount = 0;
+
+/**
+ * @brief Swap kernel used in SORT_STATS builds: counts the swap, then performs it.
+ */
+static void CountingSwap(char* a, char* b, int wide) {
+    atomic_fetch_add_explicit(&SortSwapCount, 1, memory_order_relaxed);
+    SelectSwapKernel(wide)(a, b, wide);
+}
+#endif
+
+/**
+ * @brief Selects the fastest swap kernel for elements of the given width.
+ *
+ * Sort routines call this once per sort and then swap through the returned
+ * pointer, instead of paying a byte loop (or a width dispatch) on every swap.
+ * In builds with SORT_STATS defined, the returned kernel also increments
+ * SortSwapCount.
+ *
+ * @param wide Size (in bytes) of each element.
+ * @return A swap function valid for elements of exactly 'wide' bytes.
+ */
+SwapFunc SelectSwap(int wide) {
+#ifdef SORT_STATS
+    (void)wide;
+    return CountingSwap;
+#else
+    return SelectSwapKernel(wide);
+#endif
+}
+
+/**
+ * @brief Swaps two elements in memory, each of size 'wide' bytes.
+ *
+ * This function takes two pointers, 'a' and 'b', and swaps the content of
+ * the memory they point to, assuming that each element occupies 'wide' bytes.
+ * It dispatches to the kernel returned by SelectSwap; callers swapping many
+ * elements of the same width should call SelectSwap once instead.
+ *
+ * @param a Pointer to the first element to be swapped.
+ * @param b Pointer to the second element to be swapped.
+ * @param wide Size (in bytes) of each element.
+ */
+void swap(char* a, char* b, int wide) {
+    SelectSwap(wide)(a, b, wide);
+}
+
 /**
  * @brief Performs a bubble sort on the input array.
  *
@@ -37,12 +210,691 @@ void swap(char* a, char* b, int wide) {
  *            - If the second is greater, returns negative.
  */
 void BubbleSort(void* input, int sz, int wide, int (*cmp)(void* a, void* b)) {
+    SwapFunc swapElems = SelectSwap(wide);
     for (int i = 0; i < sz - 1; i++) {
         for (int j = 0; j < sz - 1 - i; j++) {
             int result = cmp((char*)input + j * wide, (char*)input + (j + 1) * wide);
             if (result > 0) {
-                swap((char*)input + j * wide, (char*)input + (j + 1) * wide, wide);
+                swapElems((char*)input + j * wide, (char*)input + (j + 1) * wide, wide);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Returns nonzero if the element at 'a' orders strictly before the element at 'b'.
+ */
+static int Less(const SortEnv* env, char* a, char* b) {
+    return env->cmp(a, b) < 0;
+}
+
+/**
+ * @brief Swaps two elements using the kernel selected for this sort.
+ */
+static void SwapElems(const SortEnv* env, char* a, char* b) {
+    env->swapElems(a, b, (int)env->wide);
+}
+
+/**
+ * @brief Orders two elements so that *a <= *b.
+ */
+static void Sort2(const SortEnv* env, char* a, char* b) {
+    if (Less(env, b, a)) {
+        SwapElems(env, a, b);
+    }
+}
+
+/**
+ * @brief Orders three elements so that *a <= *b <= *c.
+ */
+static void Sort3(const SortEnv* env, char* a, char* b, char* c) {
+    Sort2(env, a, b);
+    Sort2(env, b, c);
+    Sort2(env, a, b);
+}
+
+/**
+ * @brief Sorts the range [begin, end) with insertion sort.
+ *
+ * If 'guarded' is zero, the element just before 'begin' must be no greater than
+ * any element of the range, which lets the inner loop skip its bounds check.
+ */
+static void InsertionSort(const SortEnv* env, char* begin, char* end, int guarded) {
+    size_t w = env->wide;
+    if (begin == end) {
+        return;
+    }
+    for (char* cur = begin + w; cur < end; cur += w) {
+        for (char* sift = cur; (!guarded || sift > begin) && Less(env, sift, sift - w); sift -= w) {
+            SwapElems(env, sift - w, sift);
+        }
+    }
+}
+
+/**
+ * @brief Attempts to insertion sort [begin, end), giving up after a few element moves.
+ *
+ * Used on ranges that looked already partitioned, so that nearly sorted input is
+ * finished in linear time without risking quadratic behavior on unsorted input.
+ *
+ * @return 1 if the range is now sorted, 0 if the move limit was exceeded.
+ */
+static int PartialInsertionSort(const SortEnv* env, char* begin, char* end) {
+    size_t w = env->wide;
+    size_t limit = 0;
+    if (begin == end) {
+        return 1;
+    }
+    for (char* cur = begin + w; cur < end; cur += w) {
+        char* sift = cur;
+        while (sift > begin && Less(env, sift, sift - w)) {
+            SwapElems(env, sift - w, sift);
+            sift -= w;
+        }
+        limit += (size_t)(cur - sift) / w;
+        if (limit > PDQ_PARTIAL_INSERTION_LIMIT) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Restores the max-heap property for the subtree rooted at 'root'.
+ */
+static void SiftDown(const SortEnv* env, char* base, size_t root, size_t n) {
+    size_t w = env->wide;
+    for (;;) {
+        size_t child = 2 * root + 1;
+        if (child >= n) {
+            return;
+        }
+        if (child + 1 < n && Less(env, base + child * w, base + (child + 1) * w)) {
+            child++;
+        }
+        if (!Less(env, base + root * w, base + child * w)) {
+            return;
+        }
+        SwapElems(env, base + root * w, base + child * w);
+        root = child;
+    }
+}
+
+/**
+ * @brief Sorts the range [begin, end) with heapsort.
+ *
+ * Serves as the O(n log n) fallback when pivot selection keeps producing
+ * unbalanced partitions.
+ */
+static void HeapSortRange(const SortEnv* env, char* begin, char* end) {
+    size_t w = env->wide;
+    size_t n = (size_t)(end - begin) / w;
+    for (size_t i = n / 2; i-- > 0;) {
+        SiftDown(env, begin, i, n);
+    }
+    for (size_t i = n; i-- > 1;) {
+        SwapElems(env, begin, begin + i * w);
+        SiftDown(env, begin, 0, i);
+    }
+}
+
+/**
+ * @brief Partitions [begin, end) around the pivot stored at 'begin'.
+ *
+ * Elements equal to the pivot go to the right partition. The pivot is moved to
+ * its final position, which is returned. '*alreadyPartitioned' is set when no
+ * element had to be swapped.
+ */
+static char* PartitionRight(const SortEnv* env, char* begin, char* end, int* alreadyPartitioned) {
+    size_t w = env->wide;
+    char* pivot = begin;
+    char* first = begin;
+    char* last = end;
+
+    // The median-of-3 guarantees an element >= pivot exists to stop this scan.
+    do {
+        first += w;
+    } while (Less(env, first, pivot));
+
+    // If nothing was smaller than the pivot, the backward scan must be bounded.
+    if (first - w == begin) {
+        do {
+            last -= w;
+        } while (first < last && !Less(env, last, pivot));
+    }
+    else {
+        do {
+            last -= w;
+        } while (!Less(env, last, pivot));
+    }
+
+    *alreadyPartitioned = first >= last;
+
+    while (first < last) {
+        SwapElems(env, first, last);
+        do {
+            first += w;
+        } while (Less(env, first, pivot));
+        do {
+            last -= w;
+        } while (!Less(env, last, pivot));
+    }
+
+    char* pivotPos = first - w;
+    SwapElems(env, begin, pivotPos);
+    return pivotPos;
+}
+
+/**
+ * @brief Partitions [begin, end) around the pivot at 'begin', sending equal elements left.
+ *
+ * Only called when the pivot equals the element preceding the range, in which
+ * case the whole left partition consists of duplicates and never needs sorting.
+ */
+static char* PartitionLeft(const SortEnv* env, char* begin, char* end) {
+    size_t w = env->wide;
+    char* pivot = begin;
+    char* first = begin;
+    char* last = end;
+
+    do {
+        last -= w;
+    } while (Less(env, pivot, last));
+
+    if (last + w == end) {
+        do {
+            first += w;
+        } while (first < last && !Less(env, pivot, first));
+    }
+    else {
+        do {
+            first += w;
+        } while (!Less(env, pivot, first));
+    }
+
+    while (first < last) {
+        SwapElems(env, first, last);
+        do {
+            last -= w;
+        } while (Less(env, pivot, last));
+        do {
+            first += w;
+        } while (!Less(env, pivot, first));
+    }
+
+    SwapElems(env, begin, last);
+    return last;
+}
+
+/**
+ * @brief Moves a median-of-3 (or ninther, for large ranges) pivot to 'begin'.
+ *
+ * Also leaves an element no smaller than the pivot near the end of the range,
+ * which PartitionRight relies on as a sentinel.
+ */
+static void ChoosePivot(const SortEnv* env, char* begin, char* end, size_t size) {
+    size_t w = env->wide;
+    size_t s2 = size / 2;
+    if (size > PDQ_NINTHER_THRESHOLD) {
+        Sort3(env, begin, begin + s2 * w, end - w);
+        Sort3(env, begin + w, begin + (s2 - 1) * w, end - 2 * w);
+        Sort3(env, begin + 2 * w, begin + (s2 + 1) * w, end - 3 * w);
+        Sort3(env, begin + (s2 - 1) * w, begin + s2 * w, begin + (s2 + 1) * w);
+        SwapElems(env, begin, begin + s2 * w);
+    }
+    else {
+        Sort3(env, begin + s2 * w, begin, end - w);
+    }
+}
+
+/**
+ * @brief Swaps a few elements of both partitions to break up patterns that caused a bad pivot.
+ */
+static void BreakPatterns(const SortEnv* env, char* begin, char* pivotPos, char* end) {
+    size_t w = env->wide;
+    size_t lSize = (size_t)(pivotPos - begin) / w;
+    size_t rSize = (size_t)(end - (pivotPos + w)) / w;
+    if (lSize >= PDQ_INSERTION_THRESHOLD) {
+        SwapElems(env, begin, begin + (lSize / 4) * w);
+        SwapElems(env, pivotPos - w, pivotPos - (lSize / 4) * w);
+        if (lSize > PDQ_NINTHER_THRESHOLD) {
+            SwapElems(env, begin + w, begin + (lSize / 4 + 1) * w);
+            SwapElems(env, begin + 2 * w, begin + (lSize / 4 + 2) * w);
+            SwapElems(env, pivotPos - 2 * w, pivotPos - (lSize / 4 + 1) * w);
+            SwapElems(env, pivotPos - 3 * w, pivotPos - (lSize / 4 + 2) * w);
+        }
+    }
+    if (rSize >= PDQ_INSERTION_THRESHOLD) {
+        SwapElems(env, pivotPos + w, pivotPos + (1 + rSize / 4) * w);
+        SwapElems(env, end - w, end - (rSize / 4) * w);
+        if (rSize > PDQ_NINTHER_THRESHOLD) {
+            SwapElems(env, pivotPos + 2 * w, pivotPos + (2 + rSize / 4) * w);
+            SwapElems(env, pivotPos + 3 * w, pivotPos + (3 + rSize / 4) * w);
+            SwapElems(env, end - 2 * w, end - (1 + rSize / 4) * w);
+            SwapElems(env, end - 3 * w, end - (2 + rSize / 4) * w);
+        }
+    }
+}
+
+/**
+ * @brief Core pattern-defeating quicksort loop over [begin, end).
+ *
+ * @param badAllowed Number of highly unbalanced partitions tolerated before
+ *                   switching to heapsort.
+ * @param leftmost Nonzero if 'begin' is the start of the whole array.
+ */
+static void PdqSortLoop(const SortEnv* env, char* begin, char* end, int badAllowed, int leftmost) {
+    size_t w = env->wide;
+    for (;;) {
+        size_t size = (size_t)(end - begin) / w;
+
+        if (size < PDQ_INSERTION_THRESHOLD) {
+            InsertionSort(env, begin, end, leftmost);
+            return;
+        }
+
+        ChoosePivot(env, begin, end, size);
+
+        // A pivot equal to the previous partition's pivot means a run of
+        // duplicates: put them all on the left and skip them.
+        if (!leftmost && !Less(env, begin - w, begin)) {
+            begin = PartitionLeft(env, begin, end) + w;
+            continue;
+        }
+
+        int alreadyPartitioned;
+        char* pivotPos = PartitionRight(env, begin, end, &alreadyPartitioned);
+
+        size_t lSize = (size_t)(pivotPos - begin) / w;
+        size_t rSize = (size_t)(end - (pivotPos + w)) / w;
+        int highlyUnbalanced = lSize < size / 8 || rSize < size / 8;
+
+        if (highlyUnbalanced) {
+            if (--badAllowed == 0) {
+                HeapSortRange(env, begin, end);
+                return;
+            }
+            BreakPatterns(env, begin, pivotPos, end);
+        }
+        else if (alreadyPartitioned
+            && PartialInsertionSort(env, begin, pivotPos)
+            && PartialInsertionSort(env, pivotPos + w, end)) {
+            // The input was (nearly) sorted; both halves are done.
+            return;
+        }
+
+        // Recurse into the left partition and loop on the right one.
+        PdqSortLoop(env, begin, pivotPos, badAllowed, leftmost);
+        begin = pivotPos + w;
+        leftmost = 0;
+    }
+}
+
+/**
+ * @brief Runs pattern-defeating quicksort over 'n' elements starting at 'begin'.
+ */
+static void PdqSortEnv(const SortEnv* env, char* begin, size_t n) {
+    int badAllowed = 0;
+    for (size_t k = n; k > 1; k >>= 1) {
+        badAllowed++;
+    }
+    PdqSortLoop(env, begin, begin + n * env->wide, badAllowed, 1);
+}
+
+/**
+ * @brief Sorts the input array with pattern-defeating quicksort.
+ *
+ * Takes the same arguments as BubbleSort but runs in O(n log n) worst-case time:
+ * quicksort with median-of-3 (ninther for large ranges) pivots, insertion sort
+ * for short ranges, and a heapsort fallback when partitions keep coming out
+ * unbalanced. Already sorted, reverse sorted and nearly sorted inputs finish in
+ * near-linear time. The sort is not stable.
+ *
+ * @param input Pointer to the array to be sorted.
+ * @param sz Number of elements in the array.
+ * @param wide Size (in bytes) of each element in the array.
+ * @param cmp Comparison function with the same contract as for BubbleSort.
+ */
+void PdqSort(void* input, int sz, int wide, int (*cmp)(void* a, void* b)) {
+    if (sz < 2 || wide <= 0) {
+        return;
+    }
+    SortEnv env;
+    env.wide = (size_t)wide;
+    env.cmp = cmp;
+    env.swapElems = SelectSwap(wide);
+    PdqSortEnv(&env, (char*)input, (size_t)sz);
+}
+
+static _Thread_local int (*recordCmp)(void* a, void* b); ///< User comparison of the PointerSort running on this thread
+
+/**
+ * @brief PointerSort's comparison: compares the records pointed to, breaking ties by address.
+ *
+ * Kept separate from Less so that direct sorts pay for no indirection check.
+ */
+static int ComparePointedTo(void* a, void* b) {
+    char* ra = *(char**)a;
+    char* rb = *(char**)b;
+    int result = recordCmp(ra, rb);
+    if (result != 0) {
+        return result;
+    }
+    return (ra > rb) - (ra < rb);
+}
+
+/**
+ * @brief Sorts an array of pointers by the records they point to.
+ *
+ * Only the pointers move, so this is the cheap way to order records that
+ * are hundreds of bytes wide. Records comparing equal are ordered by address,
+ * not by their position in 'items', so the result is stable only if the
+ * pointers point into one array in ascending order.
+ *
+ * @param items Array of pointers to records.
+ * @param sz Number of pointers in the array.
+ * @param cmp Comparison function called with two record pointers.
+ */
+void PointerSort(void** items, int sz, int (*cmp)(void* a, void* b)) {
+    if (sz < 2) {
+        return;
+    }
+    // Saved and restored so that a comparison function may itself call PointerSort.
+    int (*outer)(void* a, void* b) = recordCmp;
+    recordCmp = cmp;
+    SortEnv env;
+    env.wide = sizeof(void*);
+    env.cmp = ComparePointedTo;
+    env.swapElems = SelectSwap((int)sizeof(void*));
+    PdqSortEnv(&env, (char*)items, (size_t)sz);
+    recordCmp = outer;
+}
+
+/**
+ * @brief Computes the permutation that sorts the input, without moving any record.
+ *
+ * On return, input[index[0]], input[index[1]], ... is in ascending order, and
+ * records comparing equal appear in their original order.
+ *
+ * @param input Pointer to the array of records.
+ * @param sz Number of records in the array.
+ * @param wide Size (in bytes) of each record.
+ * @param cmp Comparison function with the same contract as for BubbleSort.
+ * @param index Output array of 'sz' positions.
+ * @return 0 on success, -1 if the temporary pointer array could not be allocated.
+ */
+int ArgSort(void* input, int sz, int wide, int (*cmp)(void* a, void* b), int* index) {
+    if (sz <= 0) {
+        return 0;
+    }
+    if (wide <= 0) {
+        // No record bytes to compare: every record is equal, so the identity is the stable order.
+        for (int i = 0; i < sz; i++) {
+            index[i] = i;
+        }
+        return 0;
+    }
+    char* base = (char*)input;
+    char** items = (char**)malloc((size_t)sz * sizeof(char*));
+    if (items == NULL) {
+        return -1;
+    }
+    for (int i = 0; i < sz; i++) {
+        items[i] = base + (size_t)i * (size_t)wide;
+    }
+    PointerSort((void**)items, sz, cmp);
+    for (int i = 0; i < sz; i++) {
+        index[i] = (int)((size_t)(items[i] - base) / (size_t)wide);
+    }
+    free(items);
+    return 0;
+}
+
+/**
+ * @brief Rearranges records in place so that the new input[i] is the old input[index[i]].
+ *
+ * Follows each cycle of the permutation once, so every record is moved a
+ * single time; only the first record of each cycle is staged in a temporary.
+ *
+ * @param input Pointer to the array of records.
+ * @param sz Number of records in the array.
+ * @param wide Size (in bytes) of each record.
+ * @param index A permutation of 0 .. sz - 1, e.g. as produced by ArgSort.
+ * @return 0 on success, -1 if the temporary buffers could not be allocated.
+ */
+int ApplyPermutation(void* input, int sz, int wide, const int* index) {
+    if (sz < 2 || wide <= 0) {
+        return 0;
+    }
+    size_t w = (size_t)wide;
+    char* base = (char*)input;
+    char* tmp = (char*)malloc(w);
+    unsigned char* done = (unsigned char*)calloc(((size_t)sz + 7) / 8, 1);
+    if (tmp == NULL || done == NULL) {
+        free(tmp);
+        free(done);
+        return -1;
+    }
+    for (int start = 0; start < sz; start++) {
+        if (done[start >> 3] & (1u << (start & 7))) {
+            continue;
+        }
+        done[start >> 3] |= (unsigned char)(1u << (start & 7));
+        if (index[start] == start) {
+            continue;
+        }
+        memcpy(tmp, base + (size_t)start * w, w);
+        int j = start;
+        for (;;) {
+            int k = index[j];
+            if (k == start) {
+                memcpy(base + (size_t)j * w, tmp, w);
+                break;
             }
+            memcpy(base + (size_t)j * w, base + (size_t)k * w, w);
+            done[k >> 3] |= (unsigned char)(1u << (k & 7));
+            j = k;
+        }
+    }
+    free(tmp);
+    free(done);
+    return 0;
+}
+
+/**
+ * @brief Sorts large records by sorting pointers first and then moving each record once.
+ *
+ * Produces the same order as StableSort would, at the cost of sz pointers and
+ * sz ints of temporary memory; worthwhile once records are more than a few
+ * dozen bytes wide.
+ *
+ * @param input Pointer to the array of records.
+ * @param sz Number of records in the array.
+ * @param wide Size (in bytes) of each record.
+ * @param cmp Comparison function with the same contract as for BubbleSort.
+ * @return 0 on success, -1 if the temporary buffers could not be allocated.
+ */
+int IndirectSort(void* input, int sz, int wide, int (*cmp)(void* a, void* b)) {
+    if (sz < 2 || wide <= 0) {
+        return 0;
+    }
+    int* index = (int*)malloc((size_t)sz * sizeof(int));
+    if (index == NULL) {
+        return -1;
+    }
+    int status = ArgSort(input, sz, wide, cmp, index);
+    if (status == 0) {
+        status = ApplyPermutation(input, sz, wide, index);
+    }
+    free(index);
+    return status;
+}
+
+/**
+ * @brief Partially sorts the array so that its first k elements are the k smallest, in order.
+ *
+ * Keeps a max-heap of the k smallest elements seen so far at the front of the
+ * array and finally sorts it, which costs O(n log k) instead of a full sort.
+ * The order of the remaining elements is unspecified.
+ *
+ * @param input Pointer to the array.
+ * @param sz Number of elements in the array.
+ * @param wide Size (in bytes) of each element.
+ * @param cmp Comparison function with the same contract as for BubbleSort.
+ * @param k Number of smallest elements to place at the front (clamped to sz).
+ */
+void PartialSort(void* input, int sz, int wide, int (*cmp)(void* a, void* b), int k) {
+    if (k > sz) {
+        k = sz;
+    }
+    if (k <= 0 || wide <= 0) {
+        return;
+    }
+    SortEnv env;
+    env.wide = (size_t)wide;
+    env.cmp = cmp;
+    env.swapElems = SelectSwap(wide);
+
+    size_t w = env.wide;
+    size_t heapLen = (size_t)k;
+    char* base = (char*)input;
+    for (size_t i = heapLen / 2; i-- > 0;) {
+        SiftDown(&env, base, i, heapLen);
+    }
+    for (size_t i = heapLen; i < (size_t)sz; i++) {
+        if (Less(&env, base + i * w, base)) {
+            SwapElems(&env, base, base + i * w);
+            SiftDown(&env, base, 0, heapLen);
+        }
+    }
+    for (size_t i = heapLen; i-- > 1;) {
+        SwapElems(&env, base, base + i * w);
+        SiftDown(&env, base, 0, i);
+    }
+}
+
+/**
+ * @brief Copies the k smallest elements of the input, in ascending order, into 'output'.
+ *
+ * The input is left untouched. 'output' doubles as the max-heap, so no other
+ * memory is used and the cost is O(n log k).
+ *
+ * @param input Pointer to the array to select from.
+ * @param sz Number of elements in the input array.
+ * @param wide Size (in bytes) of each element.
+ * @param cmp Comparison function with the same contract as for BubbleSort.
+ * @param output Destination with room for k elements.
+ * @param k Number of elements to select.
+ * @return The number of elements written to 'output' (the smaller of k and sz).
+ */
+int TopK(void* input, int sz, int wide, int (*cmp)(void* a, void* b), void* output, int k) {
+    if (k > sz) {
+        k = sz;
+    }
+    if (k <= 0 || wide <= 0) {
+        return 0;
+    }
+    SortEnv env;
+    env.wide = (size_t)wide;
+    env.cmp = cmp;
+    env.swapElems = SelectSwap(wide);
+
+    size_t w = env.wide;
+    size_t heapLen = (size_t)k;
+    char* heap = (char*)output;
+    char* src = (char*)input;
+    memcpy(heap, src, heapLen * w);
+    for (size_t i = heapLen / 2; i-- > 0;) {
+        SiftDown(&env, heap, i, heapLen);
+    }
+    for (size_t i = heapLen; i < (size_t)sz; i++) {
+        if (Less(&env, src + i * w, heap)) {
+            memcpy(heap, src + i * w, w);
+            SiftDown(&env, heap, 0, heapLen);
+        }
+    }
+    for (size_t i = heapLen; i-- > 1;) {
+        SwapElems(&env, heap, heap + i * w);
+        SiftDown(&env, heap, 0, i);
+    }
+    return k;
+}
+
+/**
+ * @brief Rearranges the array so that the element at position 'nth' is the one a full sort would put there.
+ *
+ * Every element before 'nth' is no greater than it and every element after is
+ * no smaller. Uses quickselect with the same pivot selection and duplicate
+ * handling as PdqSort, so it runs in O(n) on average; after too many
+ * unbalanced partitions it falls back to heapsort, bounding the worst case at
+ * O(n log n). Use nth = sz / 2 for the median.
+ *
+ * @param input Pointer to the array.
+ * @param sz Number of elements in the array.
+ * @param wide Size (in bytes) of each element.
+ * @param cmp Comparison function with the same contract as for BubbleSort.
+ * @param nth Zero-based position to select.
+ */
+void NthElement(void* input, int sz, int wide, int (*cmp)(void* a, void* b), int nth) {
+    if (sz < 2 || wide <= 0 || nth < 0 || nth >= sz) {
+        return;
+    }
+    SortEnv env;
+    env.wide = (size_t)wide;
+    env.cmp = cmp;
+    env.swapElems = SelectSwap(wide);
+
+    size_t w = env.wide;
+    char* begin = (char*)input;
+    char* end = begin + (size_t)sz * w;
+    char* target = begin + (size_t)nth * w;
+    int leftmost = 1;
+    int badAllowed = 0;
+    for (int n = sz; n > 1; n >>= 1) {
+        badAllowed++;
+    }
+
+    for (;;) {
+        size_t size = (size_t)(end - begin) / w;
+        if (size < PDQ_INSERTION_THRESHOLD) {
+            InsertionSort(&env, begin, end, 1);
+            return;
+        }
+
+        ChoosePivot(&env, begin, end, size);
+
+        // Everything up to the returned position equals the previous pivot.
+        if (!leftmost && !Less(&env, begin - w, begin)) {
+            char* last = PartitionLeft(&env, begin, end);
+            if (target <= last) {
+                return;
+            }
+            begin = last + w;
+            continue;
+        }
+
+        int alreadyPartitioned;
+        char* pivotPos = PartitionRight(&env, begin, end, &alreadyPartitioned);
+        if (pivotPos == target) {
+            return;
+        }
+
+        size_t lSize = (size_t)(pivotPos - begin) / w;
+        size_t rSize = (size_t)(end - (pivotPos + w)) / w;
+        if (lSize < size / 8 || rSize < size / 8) {
+            if (--badAllowed == 0) {
+                HeapSortRange(&env, begin, end);
+                return;
+            }
+            BreakPatterns(&env, begin, pivotPos, end);
+        }
+
+        if (target < pivotPos) {
+            end = pivotPos;
+        }
+        else {
+            begin = pivotPos + w;
+            leftmost = 0;
         }
     }
 }
\ No newline at end of file
@@ -1,6 +1,22 @@
 #ifndef XPERANCE_BUBBLESORT
 #define XPERANCE_BUBBLESORT
 
+/**
+ * @brief Signature shared by the width-specialized swap kernels.
+ */
+typedef void (*SwapFunc)(char* a, char* b, int wide);
+
+#ifdef SORT_STATS
+/**
+ * @brief Number of element swaps performed through SelectSwap kernels.
+ *
+ * Only present when the library is compiled with SORT_STATS defined; used by
+ * the benchmark harness. Atomic, so swaps made by ParallelSort's worker
+ * threads are all counted.
+ */
+extern _Atomic unsigned long long SortSwapCount;
+#endif
+
 /**
  * @brief Swaps two elements in memory, each with a width of 'wide' bytes.
  *
@@ -10,6 +26,17 @@
  */
 void swap(char* a, char* b, int wide);
 
+/**
+ * @brief Returns the swap kernel specialized for elements of 'wide' bytes.
+ *
+ * Covers 4, 8 and 16 bytes, multiples of a machine word, and large records
+ * (block-wise), falling back to a byte loop otherwise.
+ *
+ * @param wide The number of bytes each element occupies.
+ * @return A swap function to be called with the same 'wide'.
+ */
+SwapFunc SelectSwap(int wide);
+
 /**
  * @brief Sorts an array using the Bubble Sort algorithm.
  *
@@ -20,4 +47,104 @@ void swap(char* a, char* b, int wide);
  */
 void BubbleSort(void* input, int sz, int wide, int (*cmp)(void* a, void* b));
 
+/**
+ * @brief Sorts an array using pattern-defeating quicksort (O(n log n) worst case).
+ *
+ * Drop-in replacement for BubbleSort on large inputs. Not stable.
+ *
+ * @param input Pointer to the array to be sorted.
+ * @param sz The number of elements in the array.
+ * @param wide The size of each element in the array (in bytes).
+ * @param cmp A function pointer used to compare two elements.
+ */
+void PdqSort(void* input, int sz, int wide, int (*cmp)(void* a, void* b));
+
+/**
+ * @brief Sorts an array of pointers by the records they point to.
+ *
+ * Records comparing equal are ordered by address, not by their position in
+ * 'items'. The sort is therefore stable only if the pointers point into one
+ * array in ascending order (as ArgSort and IndirectSort set them up).
+ *
+ * @param items Array of pointers to records.
+ * @param sz The number of pointers in the array.
+ * @param cmp A function pointer used to compare two records.
+ */
+void PointerSort(void** items, int sz, int (*cmp)(void* a, void* b));
+
+/**
+ * @brief Computes the sorting permutation of an array without moving its records.
+ *
+ * @param input Pointer to the array of records.
+ * @param sz The number of records in the array.
+ * @param wide The size of each record (in bytes).
+ * @param cmp A function pointer used to compare two records.
+ * @param index Receives 'sz' positions such that input[index[0]], input[index[1]], ... is sorted.
+ * @return 0 on success, -1 on allocation failure.
+ */
+int ArgSort(void* input, int sz, int wide, int (*cmp)(void* a, void* b), int* index);
+
+/**
+ * @brief Reorders records in place so that the new input[i] is the old input[index[i]].
+ *
+ * @param input Pointer to the array of records.
+ * @param sz The number of records in the array.
+ * @param wide The size of each record (in bytes).
+ * @param index A permutation of 0 .. sz - 1.
+ * @return 0 on success, -1 on allocation failure.
+ */
+int ApplyPermutation(void* input, int sz, int wide, const int* index);
+
+/**
+ * @brief Stable sort for large records that moves each record at most once.
+ *
+ * @param input Pointer to the array of records.
+ * @param sz The number of records in the array.
+ * @param wide The size of each record (in bytes).
+ * @param cmp A function pointer used to compare two records.
+ * @return 0 on success, -1 on allocation failure.
+ */
+int IndirectSort(void* input, int sz, int wide, int (*cmp)(void* a, void* b));
+
+/**
+ * @brief Places the k smallest elements, in ascending order, at the front of the array.
+ *
+ * Runs in O(n log k); the order of the other elements is unspecified.
+ *
+ * @param input Pointer to the array.
+ * @param sz The number of elements in the array.
+ * @param wide The size of each element in the array (in bytes).
+ * @param cmp A function pointer used to compare two elements.
+ * @param k The number of smallest elements to sort into place.
+ */
+void PartialSort(void* input, int sz, int wide, int (*cmp)(void* a, void* b), int k);
+
+/**
+ * @brief Copies the k smallest elements, in ascending order, into a separate buffer.
+ *
+ * Runs in O(n log k) and leaves the input untouched.
+ *
+ * @param input Pointer to the array to select from.
+ * @param sz The number of elements in the array.
+ * @param wide The size of each element in the array (in bytes).
+ * @param cmp A function pointer used to compare two elements.
+ * @param output Buffer with room for k elements.
+ * @param k The number of elements to select.
+ * @return The number of elements written (the smaller of k and sz).
+ */
+int TopK(void* input, int sz, int wide, int (*cmp)(void* a, void* b), void* output, int k);
+
+/**
+ * @brief Moves the element that belongs at position 'nth' in sorted order into place.
+ *
+ * Smaller elements end up before it and larger ones after it, in O(n) on average.
+ *
+ * @param input Pointer to the array.
+ * @param sz The number of elements in the array.
+ * @param wide The size of each element in the array (in bytes).
+ * @param cmp A function pointer used to compare two elements.
+ * @param nth The zero-based position to select.
+ */
+void NthElement(void* input, int sz, int wide, int (*cmp)(void* a, void* b), int nth);
+
 #endif
\ No newline at end of file
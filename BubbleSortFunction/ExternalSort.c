@@ -0,0 +1,350 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "ExternalSort.h"
+#include "BubbleSort.h"
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+
+/*
+ * All runs of one pass live back to back in a single temporary file, so the
+ * number of open files stays constant no matter how many runs there are.
+ * Each run cursor seeks to its own offset before every block read.
+ */
+
+/**
+ * @brief A sorted run stored in a temporary file.
+ */
+typedef struct {
+    off_t offset; ///< Byte offset of the run's first record
+    off_t bytes; ///< Size of the run in bytes
+} Run;
+
+/**
+ * @brief Read position within one sorted run during a merge.
+ */
+typedef struct {
+    FILE* file;
+    off_t next; ///< File offset of the next block to read
+    off_t remaining; ///< Bytes of the run not yet read
+    char* buffer;
+    size_t capacity; ///< Buffer size in bytes (a multiple of the record width)
+    size_t length; ///< Bytes currently in the buffer
+    size_t pos; ///< Offset of the current record in the buffer
+} RunCursor;
+
+/**
+ * @brief Buffered writer for merge output.
+ */
+typedef struct {
+    FILE* file;
+    char* buffer;
+    size_t capacity;
+    size_t length;
+    int failed;
+} RunWriter;
+
+/**
+ * @brief Loads the next block of a run; returns 0 once the run is exhausted.
+ */
+static int RefillCursor(RunCursor* cursor) {
+    size_t want = cursor->capacity;
+    if ((off_t)want > cursor->remaining) {
+        want = (size_t)cursor->remaining;
+    }
+    cursor->length = 0;
+    cursor->pos = 0;
+    if (want == 0 || fseeko(cursor->file, cursor->next, SEEK_SET) != 0) {
+        return 0;
+    }
+    cursor->length = fread(cursor->buffer, 1, want, cursor->file);
+    cursor->next += (off_t)cursor->length;
+    cursor->remaining -= (off_t)cursor->length;
+    return cursor->length == want;
+}
+
+/**
+ * @brief Appends one record to the writer, flushing its buffer when full.
+ */
+static void WriteRecord(RunWriter* writer, const char* record, size_t wide) {
+    if (writer->length + wide > writer->capacity) {
+        if (fwrite(writer->buffer, 1, writer->length, writer->file) != writer->length) {
+            writer->failed = 1;
+        }
+        writer->length = 0;
+    }
+    memcpy(writer->buffer + writer->length, record, wide);
+    writer->length += wide;
+}
+
+/**
+ * @brief Writes out whatever is left in the writer's buffer.
+ *
+ * @return 0 on success, -1 if any write failed.
+ */
+static int FlushWriter(RunWriter* writer) {
+    if (writer->length > 0 && fwrite(writer->buffer, 1, writer->length, writer->file) != writer->length) {
+        writer->failed = 1;
+    }
+    writer->length = 0;
+    if (fflush(writer->file) != 0) {
+        writer->failed = 1;
+    }
+    return writer->failed ? -1 : 0;
+}
+
+/**
+ * @brief Returns nonzero if run a's current record orders before run b's (ties by run order).
+ */
+static int CursorLess(RunCursor* cursors, int a, int b, int (*cmp)(void* a, void* b)) {
+    int result = cmp(cursors[a].buffer + cursors[a].pos, cursors[b].buffer + cursors[b].pos);
+    return result < 0 || (result == 0 && a < b);
+}
+
+/**
+ * @brief Restores the min-heap of run indices below position 'root'.
+ */
+static void SiftCursor(int* heap, int n, int root, RunCursor* cursors, int (*cmp)(void* a, void* b)) {
+    for (;;) {
+        int child = 2 * root + 1;
+        if (child >= n) {
+            return;
+        }
+        if (child + 1 < n && CursorLess(cursors, heap[child + 1], heap[child], cmp)) {
+            child++;
+        }
+        if (!CursorLess(cursors, heap[child], heap[root], cmp)) {
+            return;
+        }
+        int t = heap[root];
+        heap[root] = heap[child];
+        heap[child] = t;
+        root = child;
+    }
+}
+
+/**
+ * @brief Merges 'count' sorted runs of 'src' into 'out' with a binary heap over the runs' current records.
+ *
+ * The budget is split evenly between one read buffer per run and the output buffer.
+ *
+ * @return 0 on success, -1 on I/O error or allocation failure.
+ */
+static int MergeRuns(FILE* src, const Run* runs, int count, FILE* out, size_t wide, int (*cmp)(void* a, void* b), size_t budget) {
+    size_t share = budget / (size_t)(count + 1) / wide * wide;
+    if (share < wide) {
+        share = wide;
+    }
+    RunCursor* cursors = (RunCursor*)calloc((size_t)count, sizeof(RunCursor));
+    int* heap = (int*)malloc((size_t)count * sizeof(int));
+    RunWriter writer;
+    writer.file = out;
+    writer.buffer = (char*)malloc(share);
+    writer.capacity = share;
+    writer.length = 0;
+    writer.failed = 0;
+    int status = -1;
+    if (cursors == NULL || heap == NULL || writer.buffer == NULL) {
+        goto Done;
+    }
+
+    int heapLen = 0;
+    for (int i = 0; i < count; i++) {
+        cursors[i].file = src;
+        cursors[i].next = runs[i].offset;
+        cursors[i].remaining = runs[i].bytes;
+        cursors[i].capacity = share;
+        cursors[i].buffer = (char*)malloc(share);
+        if (cursors[i].buffer == NULL) {
+            goto Done;
+        }
+        if (!RefillCursor(&cursors[i])) {
+            goto Done;
+        }
+        heap[heapLen++] = i;
+    }
+    for (int i = heapLen / 2; i-- > 0;) {
+        SiftCursor(heap, heapLen, i, cursors, cmp);
+    }
+
+    while (heapLen > 0) {
+        RunCursor* top = &cursors[heap[0]];
+        WriteRecord(&writer, top->buffer + top->pos, wide);
+        top->pos += wide;
+        if (top->pos >= top->length) {
+            if (top->remaining == 0) {
+                heap[0] = heap[--heapLen];
+            }
+            else if (!RefillCursor(top)) {
+                goto Done;
+            }
+        }
+        SiftCursor(heap, heapLen, 0, cursors, cmp);
+    }
+    status = FlushWriter(&writer);
+
+Done:
+    if (cursors != NULL) {
+        for (int i = 0; i < count; i++) {
+            free(cursors[i].buffer);
+        }
+    }
+    free(cursors);
+    free(heap);
+    free(writer.buffer);
+    return status;
+}
+
+/**
+ * @brief Sorts a file of fixed-width records that may be larger than memory.
+ *
+ * Phase one reads as many records as fit in the budget, sorts them with
+ * PdqSort and appends each sorted run to a tmpfile(); if the whole input fits
+ * in one run it is written straight to the output. Phase two merges up to
+ * budget / EXTERNAL_SORT_MIN_BUFFER - 1 runs at a time, repeating with the
+ * merged runs until one pass can produce the output file.
+ *
+ * @param inputPath Path of the file to sort; its size must be a multiple of 'wide'.
+ * @param outputPath Path of the sorted file to create (overwritten if it exists).
+ * @param wide The size of each record (in bytes).
+ * @param cmp A function pointer used to compare two records.
+ * @param memoryBudget Upper bound (in bytes) on the buffers used by the sort.
+ * @return 0 on success, -1 on I/O error, malformed input or insufficient memory.
+ */
+int ExternalSort(const char* inputPath, const char* outputPath, int wide, int (*cmp)(void* a, void* b), size_t memoryBudget) {
+    if (wide <= 0 || memoryBudget < 2 * (size_t)wide) {
+        return -1;
+    }
+    size_t w = (size_t)wide;
+    size_t runRecords = memoryBudget / w;
+    if (runRecords > INT_MAX) {
+        runRecords = INT_MAX;
+    }
+
+    FILE* in = fopen(inputPath, "rb");
+    if (in == NULL) {
+        return -1;
+    }
+    char* records = (char*)malloc(runRecords * w);
+    FILE* spill = NULL;
+    FILE* next = NULL;
+    Run* runs = NULL;
+    int runCount = 0;
+    int runCapacity = 0;
+    int status = -1;
+    if (records == NULL) {
+        goto Cleanup;
+    }
+
+    // Phase one: sorted runs, appended to a single spill file.
+    off_t offset = 0;
+    for (;;) {
+        size_t bytes = fread(records, 1, runRecords * w, in);
+        if (ferror(in) || bytes % w != 0) {
+            goto Cleanup;
+        }
+        size_t n = bytes / w;
+        if (n == 0 && runCount > 0) {
+            break;
+        }
+        PdqSort(records, (int)n, wide, cmp);
+
+        if (runCount == 0 && n < runRecords) {
+            // Everything fit in memory: no temporary file needed.
+            FILE* out = fopen(outputPath, "wb");
+            if (out == NULL) {
+                goto Cleanup;
+            }
+            int failed = fwrite(records, 1, bytes, out) != bytes;
+            failed |= fclose(out) != 0;
+            status = failed ? -1 : 0;
+            goto Cleanup;
+        }
+
+        if (spill == NULL && (spill = tmpfile()) == NULL) {
+            goto Cleanup;
+        }
+        if (runCount == runCapacity) {
+            int newCapacity = runCapacity ? runCapacity * 2 : 16;
+            Run* grown = (Run*)realloc(runs, (size_t)newCapacity * sizeof(Run));
+            if (grown == NULL) {
+                goto Cleanup;
+            }
+            runs = grown;
+            runCapacity = newCapacity;
+        }
+        if (fwrite(records, 1, bytes, spill) != bytes) {
+            goto Cleanup;
+        }
+        runs[runCount].offset = offset;
+        runs[runCount].bytes = (off_t)bytes;
+        runCount++;
+        offset += (off_t)bytes;
+        if (n < runRecords) {
+            break;
+        }
+    }
+    fclose(in);
+    in = NULL;
+    free(records);
+    records = NULL;
+    if (fflush(spill) != 0) {
+        goto Cleanup;
+    }
+
+    // Phase two: merge passes until one pass can write the output.
+    int fanIn = (int)(memoryBudget / EXTERNAL_SORT_MIN_BUFFER) - 1;
+    if (fanIn < 2) {
+        fanIn = 2;
+    }
+    while (runCount > fanIn) {
+        if ((next = tmpfile()) == NULL) {
+            goto Cleanup;
+        }
+        int merged = 0;
+        offset = 0;
+        for (int first = 0; first < runCount; first += fanIn) {
+            int group = runCount - first < fanIn ? runCount - first : fanIn;
+            if (MergeRuns(spill, runs + first, group, next, w, cmp, memoryBudget) != 0) {
+                goto Cleanup;
+            }
+            off_t bytes = 0;
+            for (int i = first; i < first + group; i++) {
+                bytes += runs[i].bytes;
+            }
+            runs[merged].offset = offset;
+            runs[merged].bytes = bytes;
+            merged++;
+            offset += bytes;
+        }
+        fclose(spill);
+        spill = next;
+        next = NULL;
+        runCount = merged;
+    }
+
+    FILE* out = fopen(outputPath, "wb");
+    if (out == NULL) {
+        goto Cleanup;
+    }
+    status = MergeRuns(spill, runs, runCount, out, w, cmp, memoryBudget);
+    if (fclose(out) != 0) {
+        status = -1;
+    }
+
+Cleanup:
+    if (in != NULL) {
+        fclose(in);
+    }
+    if (spill != NULL) {
+        fclose(spill);
+    }
+    if (next != NULL) {
+        fclose(next);
+    }
+    free(runs);
+    free(records);
+    return status;
+}
@@ -0,0 +1,26 @@
+#ifndef XPERANCE_EXTERNALSORT
+#define XPERANCE_EXTERNALSORT
+
+#include <stddef.h>
+
+#define EXTERNAL_SORT_MIN_BUFFER 65536 ///< Smallest read buffer (in bytes) given to each run while merging
+
+/**
+ * @brief Sorts a file of fixed-width records that may be larger than memory.
+ *
+ * Reads the input in runs that fit in 'memoryBudget', sorts each run in
+ * memory with PdqSort and spills it to a temporary file, then merges the runs
+ * with a k-way heap merge using large block reads. When there are more runs
+ * than the budget can buffer at EXTERNAL_SORT_MIN_BUFFER bytes each, they are
+ * merged in several passes. The input and output paths must differ.
+ *
+ * @param inputPath Path of the file to sort; its size must be a multiple of 'wide'.
+ * @param outputPath Path of the sorted file to create (overwritten if it exists).
+ * @param wide The size of each record (in bytes).
+ * @param cmp A function pointer used to compare two records.
+ * @param memoryBudget Upper bound (in bytes) on the buffers used by the sort.
+ * @return 0 on success, -1 on I/O error, malformed input or insufficient memory.
+ */
+int ExternalSort(const char* inputPath, const char* outputPath, int wide, int (*cmp)(void* a, void* b), size_t memoryBudget);
+
+#endif
@@ -0,0 +1,459 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "ParallelSort.h"
+#include "BubbleSort.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define TASK_SORT 0 ///< Sort one block in place with PdqSort
+#define TASK_MERGE 1 ///< Merge two sorted runs into a destination buffer
+
+/**
+ * @brief A unit of work for the pool.
+ *
+ * For TASK_SORT, 'a'/'na' is the block and 'dst' (if not NULL) receives a copy
+ * of the sorted block. For TASK_MERGE, runs 'a'/'na' and 'b'/'nb' are merged
+ * into 'dst'.
+ */
+typedef struct {
+    int kind;
+    char* a;
+    size_t na;
+    char* b;
+    size_t nb;
+    char* dst;
+} SortTask;
+
+/**
+ * @brief A worker's task deque: the owner pushes and pops at the tail, thieves take from the head.
+ */
+typedef struct {
+    pthread_mutex_t lock;
+    SortTask* items;
+    size_t head;
+    size_t tail;
+    size_t capacity;
+} TaskDeque;
+
+/**
+ * @brief Shared state of one ParallelSort call.
+ */
+typedef struct {
+    size_t wide;
+    int (*cmp)(void* a, void* b);
+    size_t cutoff;
+    int threads;
+    TaskDeque* deques;
+    pthread_mutex_t idleLock;
+    pthread_cond_t idleCond;
+    atomic_size_t queued; ///< Tasks sitting in deques
+    atomic_size_t pending; ///< Tasks queued or running
+    int shutdown;
+} SortPool;
+
+/**
+ * @brief Per-thread argument for WorkerMain.
+ */
+typedef struct {
+    SortPool* pool;
+    int id;
+} WorkerArg;
+
+/**
+ * @brief Appends a task to a worker's deque.
+ *
+ * @return 1 on success, 0 if the deque could not grow (the caller then runs the task itself).
+ */
+static int PushTask(SortPool* pool, int id, const SortTask* task) {
+    TaskDeque* dq = &pool->deques[id];
+    pthread_mutex_lock(&dq->lock);
+    if (dq->head == dq->tail) {
+        dq->head = 0;
+        dq->tail = 0;
+    }
+    if (dq->tail == dq->capacity) {
+        size_t newCapacity = dq->capacity ? dq->capacity * 2 : 64;
+        SortTask* items = (SortTask*)realloc(dq->items, newCapacity * sizeof(SortTask));
+        if (items == NULL) {
+            pthread_mutex_unlock(&dq->lock);
+            return 0;
+        }
+        dq->items = items;
+        dq->capacity = newCapacity;
+    }
+    dq->items[dq->tail++] = *task;
+    atomic_fetch_add(&pool->pending, 1);
+    atomic_fetch_add(&pool->queued, 1);
+    pthread_mutex_unlock(&dq->lock);
+
+    pthread_mutex_lock(&pool->idleLock);
+    pthread_cond_broadcast(&pool->idleCond);
+    pthread_mutex_unlock(&pool->idleLock);
+    return 1;
+}
+
+/**
+ * @brief Takes the most recently pushed task from the worker's own deque.
+ */
+static int PopTask(SortPool* pool, int id, SortTask* task) {
+    TaskDeque* dq = &pool->deques[id];
+    int found = 0;
+    pthread_mutex_lock(&dq->lock);
+    if (dq->head < dq->tail) {
+        *task = dq->items[--dq->tail];
+        atomic_fetch_sub(&pool->queued, 1);
+        found = 1;
+    }
+    pthread_mutex_unlock(&dq->lock);
+    return found;
+}
+
+/**
+ * @brief Takes the oldest task from another worker's deque.
+ */
+static int StealTask(SortPool* pool, int id, SortTask* task) {
+    for (int k = 1; k < pool->threads; k++) {
+        TaskDeque* dq = &pool->deques[(id + k) % pool->threads];
+        int found = 0;
+        pthread_mutex_lock(&dq->lock);
+        if (dq->head < dq->tail) {
+            *task = dq->items[dq->head++];
+            atomic_fetch_sub(&pool->queued, 1);
+            found = 1;
+        }
+        pthread_mutex_unlock(&dq->lock);
+        if (found) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Copies one element; constant sizes let the compiler inline the copy.
+ */
+static void CopyElem(char* dst, const char* src, size_t wide) {
+    switch (wide) {
+    case 4:
+        memcpy(dst, src, 4);
+        break;
+    case 8:
+        memcpy(dst, src, 8);
+        break;
+    case 16:
+        memcpy(dst, src, 16);
+        break;
+    default:
+        memcpy(dst, src, wide);
+        break;
+    }
+}
+
+/**
+ * @brief Returns the number of elements of [base, base + n) that order strictly before 'key'.
+ */
+static size_t LowerBound(const SortPool* pool, char* base, size_t n, char* key) {
+    size_t lo = 0;
+    while (n > 0) {
+        size_t half = n / 2;
+        if (pool->cmp(base + (lo + half) * pool->wide, key) < 0) {
+            lo += half + 1;
+            n -= half + 1;
+        }
+        else {
+            n = half;
+        }
+    }
+    return lo;
+}
+
+/**
+ * @brief Returns the number of elements of [base, base + n) that do not order after 'key'.
+ */
+static size_t UpperBound(const SortPool* pool, char* base, size_t n, char* key) {
+    size_t lo = 0;
+    while (n > 0) {
+        size_t half = n / 2;
+        if (pool->cmp(key, base + (lo + half) * pool->wide) >= 0) {
+            lo += half + 1;
+            n -= half + 1;
+        }
+        else {
+            n = half;
+        }
+    }
+    return lo;
+}
+
+/**
+ * @brief Merges two runs, splitting off halves as new tasks while the work exceeds the cutoff.
+ *
+ * Each split takes the middle of the longer run and binary searches the other
+ * run for the matching position, so the two halves can be merged independently.
+ */
+static void RunMerge(SortPool* pool, int id, SortTask* task) {
+    size_t w = pool->wide;
+    char* a = task->a;
+    char* b = task->b;
+    size_t na = task->na;
+    size_t nb = task->nb;
+    char* dst = task->dst;
+
+    while (na + nb > pool->cutoff) {
+        size_t i, j;
+        if (na >= nb) {
+            i = na / 2;
+            j = LowerBound(pool, b, nb, a + i * w);
+        }
+        else {
+            j = nb / 2;
+            i = UpperBound(pool, a, na, b + j * w);
+        }
+        SortTask right;
+        right.kind = TASK_MERGE;
+        right.a = a + i * w;
+        right.na = na - i;
+        right.b = b + j * w;
+        right.nb = nb - j;
+        right.dst = dst + (i + j) * w;
+        if (!PushTask(pool, id, &right)) {
+            break;
+        }
+        na = i;
+        nb = j;
+    }
+
+    char* aEnd = a + na * w;
+    char* bEnd = b + nb * w;
+    while (a < aEnd && b < bEnd) {
+        if (pool->cmp(b, a) < 0) {
+            CopyElem(dst, b, w);
+            b += w;
+        }
+        else {
+            CopyElem(dst, a, w);
+            a += w;
+        }
+        dst += w;
+    }
+    memcpy(dst, a, (size_t)(aEnd - a));
+    dst += aEnd - a;
+    memcpy(dst, b, (size_t)(bEnd - b));
+}
+
+/**
+ * @brief Executes one task and signals waiters when the last pending task finishes.
+ */
+static void RunTask(SortPool* pool, int id, SortTask* task) {
+    if (task->kind == TASK_SORT) {
+        PdqSort(task->a, (int)task->na, (int)pool->wide, pool->cmp);
+        if (task->dst != NULL) {
+            memcpy(task->dst, task->a, task->na * pool->wide);
+        }
+    }
+    else {
+        RunMerge(pool, id, task);
+    }
+    if (atomic_fetch_sub(&pool->pending, 1) == 1) {
+        pthread_mutex_lock(&pool->idleLock);
+        pthread_cond_broadcast(&pool->idleCond);
+        pthread_mutex_unlock(&pool->idleLock);
+    }
+}
+
+/**
+ * @brief Runs tasks until 'pending' drops to zero (caller thread) or the pool shuts down (workers).
+ */
+static void WorkLoop(SortPool* pool, int id, int untilIdle) {
+    SortTask task;
+    for (;;) {
+        if (PopTask(pool, id, &task) || StealTask(pool, id, &task)) {
+            RunTask(pool, id, &task);
+            continue;
+        }
+        pthread_mutex_lock(&pool->idleLock);
+        for (;;) {
+            if (atomic_load(&pool->queued) > 0) {
+                break;
+            }
+            if (untilIdle ? atomic_load(&pool->pending) == 0 : pool->shutdown) {
+                pthread_mutex_unlock(&pool->idleLock);
+                return;
+            }
+            pthread_cond_wait(&pool->idleCond, &pool->idleLock);
+        }
+        pthread_mutex_unlock(&pool->idleLock);
+    }
+}
+
+/**
+ * @brief Entry point of the helper threads.
+ */
+static void* WorkerMain(void* arg) {
+    WorkerArg* worker = (WorkerArg*)arg;
+    WorkLoop(worker->pool, worker->id, 0);
+    return NULL;
+}
+
+/**
+ * @brief Queues a task on worker 'id', running it immediately if it cannot be queued.
+ */
+static void Submit(SortPool* pool, int id, SortTask* task) {
+    if (!PushTask(pool, id, task)) {
+        atomic_fetch_add(&pool->pending, 1);
+        RunTask(pool, id, task);
+    }
+}
+
+/**
+ * @brief Sorts an array on multiple threads.
+ *
+ * The array is cut into about four blocks per thread (never smaller than
+ * 'cutoff'), which are sorted with PdqSort in parallel. The sorted blocks are
+ * then merged pairwise in rounds, ping-ponging between the input and a scratch
+ * buffer; each pair merge is recursively split into pieces of at most 'cutoff'
+ * elements. The calling thread works alongside the helper threads and waits
+ * at the end of each round. If the number of merge rounds is odd, the sort
+ * tasks copy their blocks into the scratch buffer so that the last round
+ * writes into the input array.
+ *
+ * @param input Pointer to the array to be sorted.
+ * @param sz The number of elements in the array.
+ * @param wide The size of each element in the array (in bytes).
+ * @param cmp A function pointer used to compare two elements.
+ * @param threads Number of threads to use, or 0 for one per online CPU.
+ * @param cutoff Smallest amount of work (in elements) handed to a thread,
+ *               or 0 for PARALLEL_SORT_CUTOFF.
+ */
+void ParallelSort(void* input, int sz, int wide, int (*cmp)(void* a, void* b), int threads, int cutoff) {
+    if (sz < 2 || wide <= 0) {
+        return;
+    }
+    if (threads <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 0 ? (int)cpus : 1;
+    }
+    if (cutoff <= 0) {
+        cutoff = PARALLEL_SORT_CUTOFF;
+    }
+    // RunMerge splits the longer run in half; with two runs of one element
+    // each a split would reproduce the same task. A cutoff of at least 2
+    // means a merge is split only when its two runs hold 3 or more elements.
+    if (cutoff < 2) {
+        cutoff = 2;
+    }
+    size_t n = (size_t)sz;
+    size_t w = (size_t)wide;
+    if (threads == 1 || n <= (size_t)cutoff) {
+        PdqSort(input, sz, wide, cmp);
+        return;
+    }
+
+    size_t blockLen = (n + (size_t)threads * 4 - 1) / ((size_t)threads * 4);
+    if (blockLen < (size_t)cutoff) {
+        blockLen = (size_t)cutoff;
+    }
+    int rounds = 0;
+    for (size_t width = blockLen; width < n; width *= 2) {
+        rounds++;
+    }
+
+    char* scratch = (char*)malloc(n * w);
+    SortPool pool;
+    pool.wide = w;
+    pool.cmp = cmp;
+    pool.cutoff = (size_t)cutoff;
+    pool.threads = threads;
+    pool.deques = (TaskDeque*)calloc((size_t)threads, sizeof(TaskDeque));
+    pthread_t* workers = (pthread_t*)malloc((size_t)threads * sizeof(pthread_t));
+    WorkerArg* args = (WorkerArg*)malloc((size_t)threads * sizeof(WorkerArg));
+    if (scratch == NULL || pool.deques == NULL || workers == NULL || args == NULL) {
+        free(scratch);
+        free(pool.deques);
+        free(workers);
+        free(args);
+        PdqSort(input, sz, wide, cmp);
+        return;
+    }
+    for (int t = 0; t < threads; t++) {
+        pthread_mutex_init(&pool.deques[t].lock, NULL);
+    }
+    pthread_mutex_init(&pool.idleLock, NULL);
+    pthread_cond_init(&pool.idleCond, NULL);
+    atomic_init(&pool.queued, 0);
+    atomic_init(&pool.pending, 0);
+    pool.shutdown = 0;
+
+    // Thread 0 is the caller; a failed pthread_create just means fewer helpers.
+    int started = 1;
+    for (int t = 1; t < threads; t++) {
+        args[t].pool = &pool;
+        args[t].id = t;
+        if (pthread_create(&workers[started], NULL, WorkerMain, &args[t]) == 0) {
+            started++;
+        }
+    }
+
+    char* src = (char*)input;
+    char* dst = scratch;
+    if (rounds % 2 == 1) {
+        src = scratch;
+        dst = (char*)input;
+    }
+
+    int next = 0;
+    for (size_t lo = 0; lo < n; lo += blockLen) {
+        SortTask task;
+        task.kind = TASK_SORT;
+        task.a = (char*)input + lo * w;
+        task.na = n - lo < blockLen ? n - lo : blockLen;
+        task.b = NULL;
+        task.nb = 0;
+        task.dst = src == scratch ? scratch + lo * w : NULL;
+        Submit(&pool, next, &task);
+        next = (next + 1) % threads;
+    }
+    WorkLoop(&pool, 0, 1);
+
+    for (size_t width = blockLen; width < n; width *= 2) {
+        for (size_t lo = 0; lo < n; lo += 2 * width) {
+            size_t mid = lo + width < n ? lo + width : n;
+            size_t hi = lo + 2 * width < n ? lo + 2 * width : n;
+            SortTask task;
+            task.kind = TASK_MERGE;
+            task.a = src + lo * w;
+            task.na = mid - lo;
+            task.b = src + mid * w;
+            task.nb = hi - mid;
+            task.dst = dst + lo * w;
+            Submit(&pool, next, &task);
+            next = (next + 1) % threads;
+        }
+        WorkLoop(&pool, 0, 1);
+        char* t = src;
+        src = dst;
+        dst = t;
+    }
+
+    pthread_mutex_lock(&pool.idleLock);
+    pool.shutdown = 1;
+    pthread_cond_broadcast(&pool.idleCond);
+    pthread_mutex_unlock(&pool.idleLock);
+    for (int t = 1; t < started; t++) {
+        pthread_join(workers[t], NULL);
+    }
+
+    for (int t = 0; t < threads; t++) {
+        pthread_mutex_destroy(&pool.deques[t].lock);
+        free(pool.deques[t].items);
+    }
+    pthread_mutex_destroy(&pool.idleLock);
+    pthread_cond_destroy(&pool.idleCond);
+    free(pool.deques);
+    free(workers);
+    free(args);
+    free(scratch);
+}
@@ -0,0 +1,26 @@
+#ifndef XPERANCE_PARALLELSORT
+#define XPERANCE_PARALLELSORT
+
+#define PARALLEL_SORT_CUTOFF 65536 ///< Default number of elements below which work stays serial
+
+/**
+ * @brief Sorts an array on multiple threads.
+ *
+ * Takes the same element arguments as BubbleSort. The array is cut into
+ * blocks that are sorted with PdqSort in parallel, then merged pairwise in
+ * rounds; every merge is split into independent pieces so that all threads
+ * stay busy until the end. Tasks are balanced with per-thread work-stealing
+ * deques. Needs a scratch buffer of sz * wide bytes; if it (or the threads)
+ * cannot be created, the array is sorted serially instead. Not stable.
+ *
+ * @param input Pointer to the array to be sorted.
+ * @param sz The number of elements in the array.
+ * @param wide The size of each element in the array (in bytes).
+ * @param cmp A function pointer used to compare two elements.
+ * @param threads Number of threads to use, or 0 for one per online CPU.
+ * @param cutoff Smallest amount of work (in elements) handed to a thread (at least 2),
+ *               or 0 for PARALLEL_SORT_CUTOFF.
+ */
+void ParallelSort(void* input, int sz, int wide, int (*cmp)(void* a, void* b), int threads, int cutoff);
+
+#endif
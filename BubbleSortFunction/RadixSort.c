@@ -0,0 +1,389 @@
+#include "RadixSort.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define RADIX_BITS 8 ///< Bits consumed per counting pass
+#define RADIX_BUCKETS (1 << RADIX_BITS) ///< Buckets per counting pass
+
+/*
+ * All entry points map their keys to unsigned integers whose natural order
+ * matches the key order, then run least-significant-digit radix sort over
+ * 8-bit digits. The histograms for every digit are built in a single pass
+ * over the input, and digits for which every key falls into the same bucket
+ * are skipped entirely. Keys are read and written through memcpy so that
+ * float and double arrays can be treated as integers without aliasing issues.
+ */
+
+/**
+ * @brief Reads the i-th 32-bit word of 'base'.
+ */
+static uint32_t Load32(const void* base, size_t i) {
+    uint32_t v;
+    memcpy(&v, (const char*)base + i * sizeof(v), sizeof(v));
+    return v;
+}
+
+/**
+ * @brief Writes the i-th 32-bit word of 'base'.
+ */
+static void Store32(void* base, size_t i, uint32_t v) {
+    memcpy((char*)base + i * sizeof(v), &v, sizeof(v));
+}
+
+/**
+ * @brief Reads the i-th 64-bit word of 'base'.
+ */
+static uint64_t Load64(const void* base, size_t i) {
+    uint64_t v;
+    memcpy(&v, (const char*)base + i * sizeof(v), sizeof(v));
+    return v;
+}
+
+/**
+ * @brief Writes the i-th 64-bit word of 'base'.
+ */
+static void Store64(void* base, size_t i, uint64_t v) {
+    memcpy((char*)base + i * sizeof(v), &v, sizeof(v));
+}
+
+/**
+ * @brief Maps float bits to an unsigned key with the same ordering.
+ */
+static uint32_t FloatKey32(uint32_t bits) {
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+/**
+ * @brief Inverse of FloatKey32.
+ */
+static uint32_t FloatUnkey32(uint32_t key) {
+    return (key & 0x80000000u) ? (key & 0x7FFFFFFFu) : ~key;
+}
+
+/**
+ * @brief Maps double bits to an unsigned key with the same ordering.
+ */
+static uint64_t FloatKey64(uint64_t bits) {
+    return (bits & 0x8000000000000000ull) ? ~bits : (bits | 0x8000000000000000ull);
+}
+
+/**
+ * @brief Inverse of FloatKey64.
+ */
+static uint64_t FloatUnkey64(uint64_t key) {
+    return (key & 0x8000000000000000ull) ? (key & 0x7FFFFFFFFFFFFFFFull) : ~key;
+}
+
+/**
+ * @brief Converts bucket counts into starting offsets.
+ *
+ * @return 1 if the digit actually splits the input, 0 if all keys share one bucket.
+ */
+static int PrefixSums(size_t* count, size_t n) {
+    size_t sum = 0;
+    for (int b = 0; b < RADIX_BUCKETS; b++) {
+        if (count[b] == n) {
+            return 0;
+        }
+        size_t c = count[b];
+        count[b] = sum;
+        sum += c;
+    }
+    return 1;
+}
+
+/**
+ * @brief LSD radix sort of unsigned 32-bit keys.
+ */
+static int RadixSortKeys32(void* a, size_t n) {
+    size_t count[4][RADIX_BUCKETS];
+    void* tmp = malloc(n * sizeof(uint32_t));
+    if (tmp == NULL) {
+        return -1;
+    }
+    memset(count, 0, sizeof(count));
+    for (size_t i = 0; i < n; i++) {
+        uint32_t k = Load32(a, i);
+        count[0][k & 0xFF]++;
+        count[1][(k >> 8) & 0xFF]++;
+        count[2][(k >> 16) & 0xFF]++;
+        count[3][k >> 24]++;
+    }
+    void* src = a;
+    void* dst = tmp;
+    for (int d = 0; d < 4; d++) {
+        if (!PrefixSums(count[d], n)) {
+            continue;
+        }
+        int shift = d * RADIX_BITS;
+        for (size_t i = 0; i < n; i++) {
+            uint32_t k = Load32(src, i);
+            Store32(dst, count[d][(k >> shift) & 0xFF]++, k);
+        }
+        void* t = src;
+        src = dst;
+        dst = t;
+    }
+    if (src != a) {
+        memcpy(a, src, n * sizeof(uint32_t));
+    }
+    free(tmp);
+    return 0;
+}
+
+/**
+ * @brief LSD radix sort of unsigned 64-bit keys.
+ */
+static int RadixSortKeys64(void* a, size_t n) {
+    size_t count[8][RADIX_BUCKETS];
+    void* tmp = malloc(n * sizeof(uint64_t));
+    if (tmp == NULL) {
+        return -1;
+    }
+    memset(count, 0, sizeof(count));
+    for (size_t i = 0; i < n; i++) {
+        uint64_t k = Load64(a, i);
+        for (int d = 0; d < 8; d++) {
+            count[d][(k >> (d * RADIX_BITS)) & 0xFF]++;
+        }
+    }
+    void* src = a;
+    void* dst = tmp;
+    for (int d = 0; d < 8; d++) {
+        if (!PrefixSums(count[d], n)) {
+            continue;
+        }
+        int shift = d * RADIX_BITS;
+        for (size_t i = 0; i < n; i++) {
+            uint64_t k = Load64(src, i);
+            Store64(dst, count[d][(k >> shift) & 0xFF]++, k);
+        }
+        void* t = src;
+        src = dst;
+        dst = t;
+    }
+    if (src != a) {
+        memcpy(a, src, n * sizeof(uint64_t));
+    }
+    free(tmp);
+    return 0;
+}
+
+/**
+ * @brief Sorts an array of uint32_t in ascending order with LSD radix sort.
+ *
+ * @param input Pointer to the array to be sorted.
+ * @param sz The number of elements in the array.
+ * @return 0 on success, -1 if the scratch buffer could not be allocated.
+ */
+int RadixSortUInt32(uint32_t* input, int sz) {
+    if (sz < 2) {
+        return 0;
+    }
+    return RadixSortKeys32(input, (size_t)sz);
+}
+
+/**
+ * @brief Sorts an array of int32_t in ascending order with LSD radix sort.
+ *
+ * Flipping the sign bit maps two's complement order onto unsigned order.
+ *
+ * @param input Pointer to the array to be sorted.
+ * @param sz The number of elements in the array.
+ * @return 0 on success, -1 if the scratch buffer could not be allocated.
+ */
+int RadixSortInt32(int32_t* input, int sz) {
+    if (sz < 2) {
+        return 0;
+    }
+    for (int i = 0; i < sz; i++) {
+        Store32(input, i, Load32(input, i) ^ 0x80000000u);
+    }
+    int status = RadixSortKeys32(input, (size_t)sz);
+    for (int i = 0; i < sz; i++) {
+        Store32(input, i, Load32(input, i) ^ 0x80000000u);
+    }
+    return status;
+}
+
+/**
+ * @brief Sorts an array of int64_t in ascending order with LSD radix sort.
+ *
+ * @param input Pointer to the array to be sorted.
+ * @param sz The number of elements in the array.
+ * @return 0 on success, -1 if the scratch buffer could not be allocated.
+ */
+int RadixSortInt64(int64_t* input, int sz) {
+    if (sz < 2) {
+        return 0;
+    }
+    for (int i = 0; i < sz; i++) {
+        Store64(input, i, Load64(input, i) ^ 0x8000000000000000ull);
+    }
+    int status = RadixSortKeys64(input, (size_t)sz);
+    for (int i = 0; i < sz; i++) {
+        Store64(input, i, Load64(input, i) ^ 0x8000000000000000ull);
+    }
+    return status;
+}
+
+/**
+ * @brief Sorts an array of float in ascending order with LSD radix sort.
+ *
+ * Negative values have all bits flipped and positive values only the sign bit,
+ * which makes the IEEE-754 bit patterns order like unsigned integers.
+ *
+ * @param input Pointer to the array to be sorted.
+ * @param sz The number of elements in the array.
+ * @return 0 on success, -1 if the scratch buffer could not be allocated.
+ */
+int RadixSortFloat(float* input, int sz) {
+    if (sz < 2) {
+        return 0;
+    }
+    for (int i = 0; i < sz; i++) {
+        Store32(input, i, FloatKey32(Load32(input, i)));
+    }
+    int status = RadixSortKeys32(input, (size_t)sz);
+    for (int i = 0; i < sz; i++) {
+        Store32(input, i, FloatUnkey32(Load32(input, i)));
+    }
+    return status;
+}
+
+/**
+ * @brief Sorts an array of double in ascending order with LSD radix sort.
+ *
+ * @param input Pointer to the array to be sorted.
+ * @param sz The number of elements in the array.
+ * @return 0 on success, -1 if the scratch buffer could not be allocated.
+ */
+int RadixSortDouble(double* input, int sz) {
+    if (sz < 2) {
+        return 0;
+    }
+    for (int i = 0; i < sz; i++) {
+        Store64(input, i, FloatKey64(Load64(input, i)));
+    }
+    int status = RadixSortKeys64(input, (size_t)sz);
+    for (int i = 0; i < sz; i++) {
+        Store64(input, i, FloatUnkey64(Load64(input, i)));
+    }
+    return status;
+}
+
+/**
+ * @brief Describes where a record's key lives and how to order it.
+ */
+typedef struct {
+    size_t offset; ///< Byte offset of the key within a record
+    int width; ///< Key width in bytes
+    int kind; ///< RADIX_KEY_* constant
+    int bigEndian; ///< Nonzero if the host stores integers most significant byte first
+} RadixKeyLayout;
+
+/**
+ * @brief Loads a record's key as an unsigned integer with the key's ordering.
+ */
+static uint64_t LoadKey(const RadixKeyLayout* layout, const char* record) {
+    const char* key = record + layout->offset;
+    uint64_t v = 0;
+    // Fixed-size copies for the common widths compile to single loads.
+    if (layout->width == 4) {
+        uint32_t v32;
+        memcpy(&v32, key, 4);
+        v = v32;
+    }
+    else if (layout->width == 8) {
+        memcpy(&v, key, 8);
+    }
+    else if (layout->bigEndian) {
+        memcpy((char*)&v + (8 - layout->width), key, (size_t)layout->width);
+    }
+    else {
+        memcpy(&v, key, (size_t)layout->width);
+    }
+    if (layout->kind == RADIX_KEY_FLOAT) {
+        return layout->width == 4 ? FloatKey32((uint32_t)v) : FloatKey64(v);
+    }
+    if (layout->kind == RADIX_KEY_SIGNED) {
+        return v ^ ((uint64_t)1 << (layout->width * 8 - 1));
+    }
+    return v;
+}
+
+/**
+ * @brief Sorts fixed-width records by a numeric key stored inside each record.
+ *
+ * Records are moved whole on each pass, so this pays off for records up to a
+ * few dozen bytes; for larger records sort an index array instead.
+ *
+ * @param input Pointer to the array of records to be sorted.
+ * @param sz The number of records in the array.
+ * @param wide The size of each record (in bytes).
+ * @param keyOffset Byte offset of the key within a record.
+ * @param keyWidth Size of the key in bytes (1 to 8; 4 or 8 for RADIX_KEY_FLOAT).
+ * @param keyKind One of RADIX_KEY_UNSIGNED, RADIX_KEY_SIGNED or RADIX_KEY_FLOAT.
+ * @return 0 on success, -1 on invalid key layout or allocation failure.
+ */
+int RadixSortRecords(void* input, int sz, int wide, int keyOffset, int keyWidth, int keyKind) {
+    if (keyWidth < 1 || keyWidth > 8 || keyOffset < 0 || keyOffset + keyWidth > wide) {
+        return -1;
+    }
+    if (keyKind == RADIX_KEY_FLOAT && keyWidth != 4 && keyWidth != 8) {
+        return -1;
+    }
+    if (keyKind != RADIX_KEY_UNSIGNED && keyKind != RADIX_KEY_SIGNED && keyKind != RADIX_KEY_FLOAT) {
+        return -1;
+    }
+    if (sz < 2) {
+        return 0;
+    }
+
+    const uint16_t probe = 1;
+    RadixKeyLayout layout;
+    layout.offset = (size_t)keyOffset;
+    layout.width = keyWidth;
+    layout.kind = keyKind;
+    layout.bigEndian = *(const char*)&probe == 0;
+
+    size_t n = (size_t)sz;
+    size_t w = (size_t)wide;
+    size_t (*count)[RADIX_BUCKETS] = calloc((size_t)keyWidth, sizeof(*count));
+    char* tmp = (char*)malloc(n * w);
+    if (count == NULL || tmp == NULL) {
+        free(count);
+        free(tmp);
+        return -1;
+    }
+
+    char* src = (char*)input;
+    for (size_t i = 0; i < n; i++) {
+        uint64_t k = LoadKey(&layout, src + i * w);
+        for (int d = 0; d < keyWidth; d++) {
+            count[d][(k >> (d * RADIX_BITS)) & 0xFF]++;
+        }
+    }
+
+    char* dst = tmp;
+    for (int d = 0; d < keyWidth; d++) {
+        if (!PrefixSums(count[d], n)) {
+            continue;
+        }
+        int shift = d * RADIX_BITS;
+        for (size_t i = 0; i < n; i++) {
+            const char* record = src + i * w;
+            uint64_t k = LoadKey(&layout, record);
+            memcpy(dst + count[d][(k >> shift) & 0xFF]++ * w, record, w);
+        }
+        char* t = src;
+        src = dst;
+        dst = t;
+    }
+    if (src != (char*)input) {
+        memcpy(input, src, n * w);
+    }
+    free(count);
+    free(tmp);
+    return 0;
+}
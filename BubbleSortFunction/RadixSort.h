@@ -0,0 +1,75 @@
+#ifndef XPERANCE_RADIXSORT
+#define XPERANCE_RADIXSORT
+
+#include <stdint.h>
+
+#define RADIX_KEY_UNSIGNED 0 ///< Record key is an unsigned integer
+#define RADIX_KEY_SIGNED 1 ///< Record key is a two's complement signed integer
+#define RADIX_KEY_FLOAT 2 ///< Record key is an IEEE-754 float (4 bytes) or double (8 bytes)
+
+/**
+ * @brief Sorts an array of uint32_t in ascending order with LSD radix sort.
+ *
+ * @param input Pointer to the array to be sorted.
+ * @param sz The number of elements in the array.
+ * @return 0 on success, -1 if the scratch buffer could not be allocated.
+ */
+int RadixSortUInt32(uint32_t* input, int sz);
+
+/**
+ * @brief Sorts an array of int32_t in ascending order with LSD radix sort.
+ *
+ * @param input Pointer to the array to be sorted.
+ * @param sz The number of elements in the array.
+ * @return 0 on success, -1 if the scratch buffer could not be allocated.
+ */
+int RadixSortInt32(int32_t* input, int sz);
+
+/**
+ * @brief Sorts an array of int64_t in ascending order with LSD radix sort.
+ *
+ * @param input Pointer to the array to be sorted.
+ * @param sz The number of elements in the array.
+ * @return 0 on success, -1 if the scratch buffer could not be allocated.
+ */
+int RadixSortInt64(int64_t* input, int sz);
+
+/**
+ * @brief Sorts an array of float in ascending order with LSD radix sort.
+ *
+ * -0.0 sorts before +0.0; NaNs with the sign bit set sort first, others last.
+ *
+ * @param input Pointer to the array to be sorted.
+ * @param sz The number of elements in the array.
+ * @return 0 on success, -1 if the scratch buffer could not be allocated.
+ */
+int RadixSortFloat(float* input, int sz);
+
+/**
+ * @brief Sorts an array of double in ascending order with LSD radix sort.
+ *
+ * -0.0 sorts before +0.0; NaNs with the sign bit set sort first, others last.
+ *
+ * @param input Pointer to the array to be sorted.
+ * @param sz The number of elements in the array.
+ * @return 0 on success, -1 if the scratch buffer could not be allocated.
+ */
+int RadixSortDouble(double* input, int sz);
+
+/**
+ * @brief Sorts fixed-width records by a numeric key stored inside each record.
+ *
+ * The sort is stable, so it can be chained from the least to the most
+ * significant key for multi-key ordering.
+ *
+ * @param input Pointer to the array of records to be sorted.
+ * @param sz The number of records in the array.
+ * @param wide The size of each record (in bytes).
+ * @param keyOffset Byte offset of the key within a record.
+ * @param keyWidth Size of the key in bytes (1 to 8; 4 or 8 for RADIX_KEY_FLOAT).
+ * @param keyKind One of RADIX_KEY_UNSIGNED, RADIX_KEY_SIGNED or RADIX_KEY_FLOAT.
+ * @return 0 on success, -1 on invalid key layout or allocation failure.
+ */
+int RadixSortRecords(void* input, int sz, int wide, int keyOffset, int keyWidth, int keyKind);
+
+#endif
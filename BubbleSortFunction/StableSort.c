@@ -0,0 +1,644 @@
+#include "StableSort.h"
+#include "BubbleSort.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define MIN_MERGE 64 ///< Arrays shorter than this are sorted with binary insertion sort alone
+#define MIN_GALLOP 7 ///< Initial number of consecutive wins before a merge switches to galloping
+#define MAX_MERGE_PENDING 64 ///< Run stack depth; enough for any array indexed by int
+
+/*
+ * This is a timsort: the input is scanned for natural runs (non-descending,
+ * or strictly descending and then reversed), short runs are extended to a
+ * minimum length with binary insertion sort, and runs are merged from a stack
+ * whose lengths are kept roughly Fibonacci-like so merges stay balanced. When
+ * one run keeps winning during a merge, the merge switches to galloping
+ * (exponential then binary search) and copies whole blocks at once.
+ */
+
+/**
+ * @brief A pending run on the merge stack.
+ */
+typedef struct {
+    char* base;
+    size_t len;
+} Run;
+
+/**
+ * @brief State of one StableSort call.
+ */
+typedef struct {
+    size_t wide;
+    int (*cmp)(void* a, void* b);
+    SwapFunc swapElems;
+    char* tmp; ///< Scratch for merges, followed by one spare element for insertion sort
+    size_t minGallop;
+    int pending;
+    Run runs[MAX_MERGE_PENDING];
+} MergeState;
+
+/**
+ * @brief Returns nonzero if 'a' orders strictly before 'b'.
+ */
+static int Lt(MergeState* ms, char* a, char* b) {
+    return ms->cmp(a, b) < 0;
+}
+
+/**
+ * @brief Computes the minimum run length for an array of n elements.
+ *
+ * Chosen so that n / minrun is a power of two or slightly less, which keeps
+ * the final merges balanced.
+ */
+static size_t MinRunLength(size_t n) {
+    size_t r = 0;
+    while (n >= MIN_MERGE) {
+        r |= n & 1;
+        n >>= 1;
+    }
+    return n + r;
+}
+
+/**
+ * @brief Sorts [lo, hi) with binary insertion sort, given that [lo, start) is already sorted.
+ *
+ * Each element is inserted after any equal elements, which keeps the sort stable.
+ */
+static void BinaryInsertionSort(MergeState* ms, char* lo, char* hi, char* start) {
+    size_t w = ms->wide;
+    char* pivot = ms->tmp;
+    for (; start < hi; start += w) {
+        size_t left = 0;
+        size_t right = (size_t)(start - lo) / w;
+        while (left < right) {
+            size_t mid = left + (right - left) / 2;
+            if (Lt(ms, start, lo + mid * w)) {
+                right = mid;
+            }
+            else {
+                left = mid + 1;
+            }
+        }
+        char* slot = lo + left * w;
+        if (slot != start) {
+            memcpy(pivot, start, w);
+            memmove(slot + w, slot, (size_t)(start - slot));
+            memcpy(slot, pivot, w);
+        }
+    }
+}
+
+/**
+ * @brief Returns the length of the run starting at lo, reversing it in place if it is descending.
+ *
+ * Descending runs must be strictly descending so that reversing them cannot
+ * reorder equal elements.
+ */
+static size_t CountRunAndMakeAscending(MergeState* ms, char* lo, char* hi) {
+    size_t w = ms->wide;
+    char* run = lo + w;
+    if (run == hi) {
+        return 1;
+    }
+    if (Lt(ms, run, lo)) {
+        while (run + w < hi && Lt(ms, run + w, run)) {
+            run += w;
+        }
+        run += w;
+        for (char* a = lo, *b = run - w; a < b; a += w, b -= w) {
+            ms->swapElems(a, b, (int)w);
+        }
+    }
+    else {
+        while (run + w < hi && !Lt(ms, run + w, run)) {
+            run += w;
+        }
+        run += w;
+    }
+    return (size_t)(run - lo) / w;
+}
+
+/**
+ * @brief Locates the position at which to insert 'key' before any equal elements of a[0..n).
+ *
+ * Starts at a[hint] and searches exponentially outward, then binary searches
+ * the bracketed range, so the cost is logarithmic in the distance from the hint.
+ *
+ * @return k such that a[k - 1] < key <= a[k].
+ */
+static size_t GallopLeft(MergeState* ms, char* key, char* a, size_t n, size_t hint) {
+    size_t w = ms->wide;
+    ptrdiff_t lastofs = 0;
+    ptrdiff_t ofs = 1;
+    char* h = a + hint * w;
+
+    if (Lt(ms, h, key)) {
+        // a[hint] < key: gallop right until a[hint + lastofs] < key <= a[hint + ofs]
+        ptrdiff_t maxofs = (ptrdiff_t)(n - hint);
+        while (ofs < maxofs && Lt(ms, h + ofs * w, key)) {
+            lastofs = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+        if (ofs > maxofs) {
+            ofs = maxofs;
+        }
+        lastofs += (ptrdiff_t)hint;
+        ofs += (ptrdiff_t)hint;
+    }
+    else {
+        // key <= a[hint]: gallop left until a[hint - ofs] < key <= a[hint - lastofs]
+        ptrdiff_t maxofs = (ptrdiff_t)hint + 1;
+        while (ofs < maxofs && !Lt(ms, h - ofs * w, key)) {
+            lastofs = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+        if (ofs > maxofs) {
+            ofs = maxofs;
+        }
+        ptrdiff_t k = lastofs;
+        lastofs = (ptrdiff_t)hint - ofs;
+        ofs = (ptrdiff_t)hint - k;
+    }
+
+    // Now a[lastofs] < key <= a[ofs]; binary search in between.
+    ++lastofs;
+    while (lastofs < ofs) {
+        ptrdiff_t m = lastofs + ((ofs - lastofs) >> 1);
+        if (Lt(ms, a + m * w, key)) {
+            lastofs = m + 1;
+        }
+        else {
+            ofs = m;
+        }
+    }
+    return (size_t)ofs;
+}
+
+/**
+ * @brief Like GallopLeft, but finds the position after any elements equal to 'key'.
+ *
+ * @return k such that a[k - 1] <= key < a[k].
+ */
+static size_t GallopRight(MergeState* ms, char* key, char* a, size_t n, size_t hint) {
+    size_t w = ms->wide;
+    ptrdiff_t lastofs = 0;
+    ptrdiff_t ofs = 1;
+    char* h = a + hint * w;
+
+    if (Lt(ms, key, h)) {
+        // key < a[hint]: gallop left until a[hint - ofs] <= key < a[hint - lastofs]
+        ptrdiff_t maxofs = (ptrdiff_t)hint + 1;
+        while (ofs < maxofs && Lt(ms, key, h - ofs * w)) {
+            lastofs = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+        if (ofs > maxofs) {
+            ofs = maxofs;
+        }
+        ptrdiff_t k = lastofs;
+        lastofs = (ptrdiff_t)hint - ofs;
+        ofs = (ptrdiff_t)hint - k;
+    }
+    else {
+        // a[hint] <= key: gallop right until a[hint + lastofs] <= key < a[hint + ofs]
+        ptrdiff_t maxofs = (ptrdiff_t)(n - hint);
+        while (ofs < maxofs && !Lt(ms, key, h + ofs * w)) {
+            lastofs = ofs;
+            ofs = (ofs << 1) + 1;
+        }
+        if (ofs > maxofs) {
+            ofs = maxofs;
+        }
+        lastofs += (ptrdiff_t)hint;
+        ofs += (ptrdiff_t)hint;
+    }
+
+    ++lastofs;
+    while (lastofs < ofs) {
+        ptrdiff_t m = lastofs + ((ofs - lastofs) >> 1);
+        if (Lt(ms, key, a + m * w)) {
+            ofs = m;
+        }
+        else {
+            lastofs = m + 1;
+        }
+    }
+    return (size_t)ofs;
+}
+
+/**
+ * @brief Merges adjacent runs a[0..na) and b[0..nb) where na <= nb, working left to right.
+ *
+ * Requires na > 0, nb > 0, b[0] < a[0] and a[na - 1] to be greater than every element of b
+ * except possibly the last (MergeAt trims the runs to guarantee this).
+ */
+static void MergeLo(MergeState* ms, char* a, size_t na, char* b, size_t nb) {
+    size_t w = ms->wide;
+    size_t minGallop = ms->minGallop;
+    char* dest = a;
+    char* pa = ms->tmp;
+    char* pb = b;
+    memcpy(pa, a, na * w);
+
+    memcpy(dest, pb, w);
+    dest += w;
+    pb += w;
+    if (--nb == 0) {
+        goto Succeed;
+    }
+    if (na == 1) {
+        goto CopyB;
+    }
+
+    for (;;) {
+        size_t acount = 0;
+        size_t bcount = 0;
+
+        // Straightforward merge until one run wins minGallop times in a row.
+        for (;;) {
+            if (Lt(ms, pb, pa)) {
+                memcpy(dest, pb, w);
+                dest += w;
+                pb += w;
+                ++bcount;
+                acount = 0;
+                if (--nb == 0) {
+                    goto Succeed;
+                }
+                if (bcount >= minGallop) {
+                    break;
+                }
+            }
+            else {
+                memcpy(dest, pa, w);
+                dest += w;
+                pa += w;
+                ++acount;
+                bcount = 0;
+                if (--na == 1) {
+                    goto CopyB;
+                }
+                if (acount >= minGallop) {
+                    break;
+                }
+            }
+        }
+
+        // Gallop until neither run wins MIN_GALLOP times in a row.
+        ++minGallop;
+        do {
+            minGallop -= minGallop > 1;
+            ms->minGallop = minGallop;
+
+            size_t k = GallopRight(ms, pb, pa, na, 0);
+            acount = k;
+            if (k) {
+                memcpy(dest, pa, k * w);
+                dest += k * w;
+                pa += k * w;
+                na -= k;
+                if (na == 1) {
+                    goto CopyB;
+                }
+                // na == 0 is only possible with an inconsistent comparison function.
+                if (na == 0) {
+                    goto Succeed;
+                }
+            }
+            memcpy(dest, pb, w);
+            dest += w;
+            pb += w;
+            if (--nb == 0) {
+                goto Succeed;
+            }
+
+            k = GallopLeft(ms, pa, pb, nb, 0);
+            bcount = k;
+            if (k) {
+                memmove(dest, pb, k * w);
+                dest += k * w;
+                pb += k * w;
+                nb -= k;
+                if (nb == 0) {
+                    goto Succeed;
+                }
+            }
+            memcpy(dest, pa, w);
+            dest += w;
+            pa += w;
+            if (--na == 1) {
+                goto CopyB;
+            }
+        } while (acount >= MIN_GALLOP || bcount >= MIN_GALLOP);
+        ++minGallop;
+        ms->minGallop = minGallop;
+    }
+
+Succeed:
+    if (na) {
+        memcpy(dest, pa, na * w);
+    }
+    return;
+
+CopyB:
+    // The last element of a belongs at the end of the merge.
+    memmove(dest, pb, nb * w);
+    memcpy(dest + nb * w, pa, w);
+}
+
+/**
+ * @brief Merges adjacent runs a[0..na) and b[0..nb) where na >= nb, working right to left.
+ *
+ * Same preconditions as MergeLo.
+ */
+static void MergeHi(MergeState* ms, char* a, size_t na, char* b, size_t nb) {
+    size_t w = ms->wide;
+    size_t minGallop = ms->minGallop;
+    char* baseb = ms->tmp;
+    char* dest = b + (nb - 1) * w;
+    char* pa = a + (na - 1) * w;
+    char* pb = baseb + (nb - 1) * w;
+    memcpy(baseb, b, nb * w);
+
+    memcpy(dest, pa, w);
+    dest -= w;
+    pa -= w;
+    if (--na == 0) {
+        goto Succeed;
+    }
+    if (nb == 1) {
+        goto CopyA;
+    }
+
+    for (;;) {
+        size_t acount = 0;
+        size_t bcount = 0;
+
+        for (;;) {
+            if (Lt(ms, pb, pa)) {
+                memcpy(dest, pa, w);
+                dest -= w;
+                pa -= w;
+                ++acount;
+                bcount = 0;
+                if (--na == 0) {
+                    goto Succeed;
+                }
+                if (acount >= minGallop) {
+                    break;
+                }
+            }
+            else {
+                memcpy(dest, pb, w);
+                dest -= w;
+                pb -= w;
+                ++bcount;
+                acount = 0;
+                if (--nb == 1) {
+                    goto CopyA;
+                }
+                if (bcount >= minGallop) {
+                    break;
+                }
+            }
+        }
+
+        ++minGallop;
+        do {
+            minGallop -= minGallop > 1;
+            ms->minGallop = minGallop;
+
+            size_t k = na - GallopRight(ms, pb, a, na, na - 1);
+            acount = k;
+            if (k) {
+                dest -= k * w;
+                pa -= k * w;
+                memmove(dest + w, pa + w, k * w);
+                na -= k;
+                if (na == 0) {
+                    goto Succeed;
+                }
+            }
+            memcpy(dest, pb, w);
+            dest -= w;
+            pb -= w;
+            if (--nb == 1) {
+                goto CopyA;
+            }
+
+            k = nb - GallopLeft(ms, pa, baseb, nb, nb - 1);
+            bcount = k;
+            if (k) {
+                dest -= k * w;
+                pb -= k * w;
+                memcpy(dest + w, pb + w, k * w);
+                nb -= k;
+                if (nb == 1) {
+                    goto CopyA;
+                }
+                // nb == 0 is only possible with an inconsistent comparison function.
+                if (nb == 0) {
+                    goto Succeed;
+                }
+            }
+            memcpy(dest, pa, w);
+            dest -= w;
+            pa -= w;
+            if (--na == 0) {
+                goto Succeed;
+            }
+        } while (acount >= MIN_GALLOP || bcount >= MIN_GALLOP);
+        ++minGallop;
+        ms->minGallop = minGallop;
+    }
+
+Succeed:
+    if (nb) {
+        memcpy(dest - (nb - 1) * w, baseb, nb * w);
+    }
+    return;
+
+CopyA:
+    // The first element of b belongs at the front of the merge.
+    dest -= na * w;
+    pa -= na * w;
+    memmove(dest + w, pa + w, na * w);
+    memcpy(dest, pb, w);
+}
+
+/**
+ * @brief Merges the runs at stack positions i and i + 1.
+ */
+static void MergeAt(MergeState* ms, int i) {
+    size_t w = ms->wide;
+    char* a = ms->runs[i].base;
+    size_t na = ms->runs[i].len;
+    char* b = ms->runs[i + 1].base;
+    size_t nb = ms->runs[i + 1].len;
+
+    ms->runs[i].len = na + nb;
+    if (i == ms->pending - 3) {
+        ms->runs[i + 1] = ms->runs[i + 2];
+    }
+    ms->pending--;
+
+    // Elements of a that are <= b[0] are already in place.
+    size_t k = GallopRight(ms, b, a, na, 0);
+    a += k * w;
+    na -= k;
+    if (na == 0) {
+        return;
+    }
+    // Elements of b that are >= a[na - 1] are already in place.
+    nb = GallopLeft(ms, a + (na - 1) * w, b, nb, nb - 1);
+    if (nb == 0) {
+        return;
+    }
+
+    if (na <= nb) {
+        MergeLo(ms, a, na, b, nb);
+    }
+    else {
+        MergeHi(ms, a, na, b, nb);
+    }
+}
+
+/**
+ * @brief Merges runs until the stack invariants hold again.
+ *
+ * The invariants are len[i - 2] > len[i - 1] + len[i] and len[i - 1] > len[i]
+ * for the top runs, checked four deep to keep them valid for the whole stack.
+ */
+static void MergeCollapse(MergeState* ms) {
+    Run* r = ms->runs;
+    while (ms->pending > 1) {
+        int n = ms->pending - 2;
+        if ((n > 0 && r[n - 1].len <= r[n].len + r[n + 1].len)
+            || (n > 1 && r[n - 2].len <= r[n - 1].len + r[n].len)) {
+            if (r[n - 1].len < r[n + 1].len) {
+                n--;
+            }
+            MergeAt(ms, n);
+        }
+        else if (r[n].len <= r[n + 1].len) {
+            MergeAt(ms, n);
+        }
+        else {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Merges all remaining runs into one.
+ */
+static void MergeForceCollapse(MergeState* ms) {
+    Run* r = ms->runs;
+    while (ms->pending > 1) {
+        int n = ms->pending - 2;
+        if (n > 0 && r[n - 1].len < r[n + 1].len) {
+            n--;
+        }
+        MergeAt(ms, n);
+    }
+}
+
+/**
+ * @brief Returns the scratch buffer size (in bytes) StableSortWithBuffer needs.
+ *
+ * Merges copy the shorter of two runs, which is at most half the array, and
+ * binary insertion sort needs room for one more element.
+ *
+ * @param sz The number of elements to be sorted.
+ * @param wide The size of each element (in bytes).
+ * @return The minimum size of the scratch buffer in bytes.
+ */
+size_t StableSortBufferSize(int sz, int wide) {
+    if (sz < 2 || wide <= 0) {
+        return 0;
+    }
+    return ((size_t)sz / 2 + 1) * (size_t)wide;
+}
+
+/**
+ * @brief Same as StableSort, but uses a caller-provided scratch buffer instead of allocating.
+ *
+ * @param input Pointer to the array to be sorted.
+ * @param sz The number of elements in the array.
+ * @param wide The size of each element in the array (in bytes).
+ * @param cmp A function pointer used to compare two elements.
+ * @param scratch Scratch buffer, suitably aligned for the element type.
+ * @param scratchBytes Size of 'scratch'; at least StableSortBufferSize(sz, wide).
+ * @return 0 on success, -1 if the scratch buffer is too small.
+ */
+int StableSortWithBuffer(void* input, int sz, int wide, int (*cmp)(void* a, void* b), void* scratch, size_t scratchBytes) {
+    if (sz < 2 || wide <= 0) {
+        return 0;
+    }
+    if (scratch == NULL || scratchBytes < StableSortBufferSize(sz, wide)) {
+        return -1;
+    }
+
+    MergeState ms;
+    ms.wide = (size_t)wide;
+    ms.cmp = cmp;
+    ms.swapElems = SelectSwap(wide);
+    ms.minGallop = MIN_GALLOP;
+    ms.pending = 0;
+
+    size_t w = ms.wide;
+    size_t remaining = (size_t)sz;
+    char* lo = (char*)input;
+    char* hi = lo + remaining * w;
+    // The insertion-sort pivot slot goes last so merges can use the rest.
+    ms.tmp = (char*)scratch;
+    char* spare = (char*)scratch + ((size_t)sz / 2) * w;
+
+    size_t minRun = MinRunLength(remaining);
+    do {
+        size_t runLen = CountRunAndMakeAscending(&ms, lo, hi);
+        if (runLen < minRun) {
+            size_t force = remaining <= minRun ? remaining : minRun;
+            char* merges = ms.tmp;
+            ms.tmp = spare;
+            BinaryInsertionSort(&ms, lo, lo + force * w, lo + runLen * w);
+            ms.tmp = merges;
+            runLen = force;
+        }
+        ms.runs[ms.pending].base = lo;
+        ms.runs[ms.pending].len = runLen;
+        ms.pending++;
+        MergeCollapse(&ms);
+        lo += runLen * w;
+        remaining -= runLen;
+    } while (remaining != 0);
+
+    MergeForceCollapse(&ms);
+    return 0;
+}
+
+/**
+ * @brief Sorts an array with a stable O(n log n) merge sort.
+ *
+ * Allocates a scratch buffer of StableSortBufferSize(sz, wide) bytes for the
+ * duration of the call; use StableSortWithBuffer to avoid the allocation.
+ *
+ * @param input Pointer to the array to be sorted.
+ * @param sz The number of elements in the array.
+ * @param wide The size of each element in the array (in bytes).
+ * @param cmp A function pointer used to compare two elements.
+ * @return 0 on success, -1 if the scratch buffer could not be allocated.
+ */
+int StableSort(void* input, int sz, int wide, int (*cmp)(void* a, void* b)) {
+    size_t bytes = StableSortBufferSize(sz, wide);
+    if (bytes == 0) {
+        return 0;
+    }
+    void* scratch = malloc(bytes);
+    if (scratch == NULL) {
+        return -1;
+    }
+    int status = StableSortWithBuffer(input, sz, wide, cmp, scratch, bytes);
+    free(scratch);
+    return status;
+}
@@ -0,0 +1,45 @@
+#ifndef XPERANCE_STABLESORT
+#define XPERANCE_STABLESORT
+
+#include <stddef.h>
+
+/**
+ * @brief Sorts an array with a stable O(n log n) merge sort.
+ *
+ * Equal elements keep their original order, as with BubbleSort, so records
+ * can be sorted by a secondary key and then by a primary key. Already sorted
+ * or reverse sorted stretches of the input are detected and merged as runs.
+ *
+ * @param input Pointer to the array to be sorted.
+ * @param sz The number of elements in the array.
+ * @param wide The size of each element in the array (in bytes).
+ * @param cmp A function pointer used to compare two elements.
+ * @return 0 on success, -1 if the scratch buffer could not be allocated.
+ */
+int StableSort(void* input, int sz, int wide, int (*cmp)(void* a, void* b));
+
+/**
+ * @brief Returns the scratch buffer size (in bytes) StableSortWithBuffer needs.
+ *
+ * @param sz The number of elements to be sorted.
+ * @param wide The size of each element (in bytes).
+ * @return The minimum size of the scratch buffer in bytes.
+ */
+size_t StableSortBufferSize(int sz, int wide);
+
+/**
+ * @brief Same as StableSort, but uses a caller-provided scratch buffer instead of allocating.
+ *
+ * The buffer may be reused across calls, so repeated sorts do not touch the allocator.
+ *
+ * @param input Pointer to the array to be sorted.
+ * @param sz The number of elements in the array.
+ * @param wide The size of each element in the array (in bytes).
+ * @param cmp A function pointer used to compare two elements.
+ * @param scratch Scratch buffer, suitably aligned for the element type.
+ * @param scratchBytes Size of 'scratch'; at least StableSortBufferSize(sz, wide).
+ * @return 0 on success, -1 if the scratch buffer is too small.
+ */
+int StableSortWithBuffer(void* input, int sz, int wide, int (*cmp)(void* a, void* b), void* scratch, size_t scratchBytes);
+
+#endif
@@ -0,0 +1,12 @@
+#include "TypedSort.h"
+
+/*
+ * Instantiations of DEFINE_TYPED_SORT for the built-in key types. User key
+ * types are instantiated the same way in the translation unit that needs them.
+ */
+
+DEFINE_TYPED_SORT(, SortInt32, int32_t, TYPED_SORT_LESS)
+DEFINE_TYPED_SORT(, SortUInt32, uint32_t, TYPED_SORT_LESS)
+DEFINE_TYPED_SORT(, SortInt64, int64_t, TYPED_SORT_LESS)
+DEFINE_TYPED_SORT(, SortFloat, float, TYPED_SORT_LESS)
+DEFINE_TYPED_SORT(, SortDouble, double, TYPED_SORT_LESS)
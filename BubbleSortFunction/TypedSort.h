@@ -0,0 +1,185 @@
+#ifndef XPERANCE_TYPEDSORT
+#define XPERANCE_TYPEDSORT
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define TYPED_SORT_INSERTION_THRESHOLD 16 ///< Ranges this short are finished with insertion sort
+
+/**
+ * @brief Default ordering for arithmetic key types.
+ *
+ * For float and double, NaN values do not form a strict weak ordering and
+ * leave the result unspecified; filter them out or use a custom Less.
+ */
+#define TYPED_SORT_LESS(a, b) ((a) < (b))
+
+/**
+ * @brief Generates an introsort specialized for one element type.
+ *
+ * Unlike PdqSort, which calls 'cmp' through a function pointer and swaps raw
+ * bytes, the generated function compares with 'Less' and moves whole values,
+ * so the compiler can inline and vectorize the inner loops.
+ *
+ * The generated entry point is:
+ *     scope void Name(Type* input, int sz);
+ * together with a few static helpers whose names start with 'Name'.
+ *
+ * Example:
+ *     typedef struct { uint64_t key; char payload[8]; } Record;
+ *     #define RECORD_LESS(a, b) ((a).key < (b).key)
+ *     DEFINE_TYPED_SORT(static, SortRecords, Record, RECORD_LESS)
+ *
+ * @param scope Storage class of the entry point (e.g. 'static', or empty).
+ * @param Name Name of the generated sort function.
+ * @param Type Element type.
+ * @param Less Function-like macro or function taking two values and returning
+ *             nonzero if the first orders strictly before the second.
+ */
+#define DEFINE_TYPED_SORT(scope, Name, Type, Less)                                      \
+static void Name##InsertionSort(Type* a, ptrdiff_t n) {                                 \
+    for (ptrdiff_t i = 1; i < n; i++) {                                                 \
+        Type tmp = a[i];                                                                \
+        ptrdiff_t j = i;                                                                \
+        while (j > 0 && Less(tmp, a[j - 1])) {                                          \
+            a[j] = a[j - 1];                                                            \
+            j--;                                                                        \
+        }                                                                               \
+        a[j] = tmp;                                                                     \
+    }                                                                                   \
+}                                                                                       \
+                                                                                        \
+static void Name##SiftDown(Type* a, ptrdiff_t root, ptrdiff_t n) {                      \
+    Type tmp = a[root];                                                                 \
+    for (;;) {                                                                          \
+        ptrdiff_t child = 2 * root + 1;                                                 \
+        if (child >= n) {                                                               \
+            break;                                                                      \
+        }                                                                               \
+        if (child + 1 < n && Less(a[child], a[child + 1])) {                            \
+            child++;                                                                    \
+        }                                                                               \
+        if (!Less(tmp, a[child])) {                                                     \
+            break;                                                                      \
+        }                                                                               \
+        a[root] = a[child];                                                             \
+        root = child;                                                                   \
+    }                                                                                   \
+    a[root] = tmp;                                                                      \
+}                                                                                       \
+                                                                                        \
+static void Name##HeapSort(Type* a, ptrdiff_t n) {                                      \
+    for (ptrdiff_t i = n / 2; i-- > 0;) {                                               \
+        Name##SiftDown(a, i, n);                                                        \
+    }                                                                                   \
+    for (ptrdiff_t i = n; i-- > 1;) {                                                   \
+        Type tmp = a[0];                                                                \
+        a[0] = a[i];                                                                    \
+        a[i] = tmp;                                                                     \
+        Name##SiftDown(a, 0, i);                                                        \
+    }                                                                                   \
+}                                                                                       \
+                                                                                        \
+static void Name##Sort2(Type* a, Type* b) {                                             \
+    if (Less(*b, *a)) {                                                                 \
+        Type tmp = *a;                                                                  \
+        *a = *b;                                                                        \
+        *b = tmp;                                                                       \
+    }                                                                                   \
+}                                                                                       \
+                                                                                        \
+static void Name##Loop(Type* a, ptrdiff_t n, int depth) {                               \
+    while (n > TYPED_SORT_INSERTION_THRESHOLD) {                                        \
+        if (depth-- == 0) {                                                             \
+            Name##HeapSort(a, n);                                                       \
+            return;                                                                     \
+        }                                                                               \
+        /* Median of three; the pivot value is never taken from a[n - 1], */            \
+        /* which keeps both Hoare partitions non-empty. */                              \
+        ptrdiff_t mid = n / 2;                                                          \
+        Name##Sort2(&a[0], &a[mid]);                                                    \
+        Name##Sort2(&a[mid], &a[n - 1]);                                                \
+        Name##Sort2(&a[0], &a[mid]);                                                    \
+        Type pivot = a[mid];                                                            \
+        ptrdiff_t i = -1;                                                               \
+        ptrdiff_t j = n;                                                                \
+        for (;;) {                                                                      \
+            do {                                                                        \
+                i++;                                                                    \
+            } while (Less(a[i], pivot));                                                \
+            do {                                                                        \
+                j--;                                                                    \
+            } while (Less(pivot, a[j]));                                                \
+            if (i >= j) {                                                               \
+                break;                                                                  \
+            }                                                                           \
+            Type tmp = a[i];                                                            \
+            a[i] = a[j];                                                                \
+            a[j] = tmp;                                                                 \
+        }                                                                               \
+        /* Recurse into the smaller side, loop on the larger one. */                    \
+        ptrdiff_t left = j + 1;                                                         \
+        if (left < n - left) {                                                          \
+            Name##Loop(a, left, depth);                                                 \
+            a += left;                                                                  \
+            n -= left;                                                                  \
+        }                                                                               \
+        else {                                                                          \
+            Name##Loop(a + left, n - left, depth);                                      \
+            n = left;                                                                   \
+        }                                                                               \
+    }                                                                                   \
+    Name##InsertionSort(a, n);                                                          \
+}                                                                                       \
+                                                                                        \
+scope void Name(Type* input, int sz) {                                                  \
+    int depth = 0;                                                                      \
+    for (int n = sz; n > 1; n >>= 1) {                                                  \
+        depth += 2;                                                                     \
+    }                                                                                   \
+    if (sz > 1) {                                                                       \
+        Name##Loop(input, sz, depth);                                                   \
+    }                                                                                   \
+}
+
+/**
+ * @brief Sorts an array of int32_t in ascending order.
+ *
+ * @param input Pointer to the array to be sorted.
+ * @param sz The number of elements in the array.
+ */
+void SortInt32(int32_t* input, int sz);
+
+/**
+ * @brief Sorts an array of uint32_t in ascending order.
+ *
+ * @param input Pointer to the array to be sorted.
+ * @param sz The number of elements in the array.
+ */
+void SortUInt32(uint32_t* input, int sz);
+
+/**
+ * @brief Sorts an array of int64_t in ascending order.
+ *
+ * @param input Pointer to the array to be sorted.
+ * @param sz The number of elements in the array.
+ */
+void SortInt64(int64_t* input, int sz);
+
+/**
+ * @brief Sorts an array of float in ascending order (must not contain NaN).
+ *
+ * @param input Pointer to the array to be sorted.
+ * @param sz The number of elements in the array.
+ */
+void SortFloat(float* input, int sz);
+
+/**
+ * @brief Sorts an array of double in ascending order (must not contain NaN).
+ *
+ * @param input Pointer to the array to be sorted.
+ * @param sz The number of elements in the array.
+ */
+void SortDouble(double* input, int sz);
+
+#endif
@@ -0,0 +1,398 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "BubbleSort.h"
+#include "StableSort.h"
+#include "TypedSort.h"
+#include "RadixSort.h"
+#include "ParallelSort.h"
+#include "ExternalSort.h"
+
+/*
+ * This is the benchmark harness for the sort module. It runs every sort entry
+ * point against six input distributions (random, sorted, reverse sorted, few
+ * unique, organ pipe and nearly sorted), at sizes 10, 100, ... up to 10^7 and
+ * element widths of 4, 8, 16, 64 and 256 bytes. Every element is a record
+ * whose first 4 bytes hold an int32 key; the rest is payload.
+ *
+ * Build (from this directory):
+ *     cc -O2 -std=c11 -pthread benchmark.c BubbleSort.c StableSort.c TypedSort.c \
+ *        RadixSort.c ParallelSort.c ExternalSort.c -o benchmark
+ * Add -DSORT_STATS to fill in the swaps column (timings then include the
+ * counting overhead).
+ *
+ * Usage:
+ *     ./benchmark [maxSize] [output.csv]
+ *     ./benchmark --typed
+ *
+ * One CSV line is written per (algorithm, distribution, size, width):
+ *     algorithm,distribution,size,width,ns_per_element,comparisons,swaps
+ * Counters are per sort call; -1 means the counter does not apply (e.g.
+ * comparisons of the multithreaded sort, or swaps in a build without
+ * SORT_STATS). Quadratic and disk-based entry points are only run up to their
+ * own size limits, and configurations needing more than BENCH_MAX_BYTES per
+ * buffer are skipped.
+ *
+ * With --typed, the harness instead prints the comparison of the generic
+ * function-pointer sort (PdqSort with a 'cmp' callback) against the sorts
+ * generated by DEFINE_TYPED_SORT, on BENCH_TYPED_SIZE random keys of each
+ * type, with the time per element of both paths and the typed speedup.
+ */
+
+#define BENCH_DEFAULT_MAX_SIZE 10000000 ///< Largest array size measured by default
+#define BENCH_MAX_BYTES ((size_t)1 << 30) ///< Largest input buffer the harness allocates
+#define BENCH_TARGET_ELEMENTS 200000 ///< Small sizes are repeated until this many elements were sorted
+#define BENCH_SELECT_K 100 ///< k used for PartialSort and TopK
+#define BENCH_TYPED_SIZE 1000000 ///< Number of elements sorted per run in the --typed table
+#define BENCH_TYPED_RUNS 5 ///< Runs per --typed measurement; the fastest is reported
+
+typedef struct {
+    const char* name;
+    int (*run)(char* data, int n, int wide); ///< Sorts 'data'; returns nonzero on failure
+    int maxSize; ///< Largest size this entry point is run at
+    int onlyWide; ///< If nonzero, the only element width the entry point supports
+    int counted; ///< 1 if comparisons and swaps can be counted, 2 if only swaps (comparisons run on worker threads)
+    int check; ///< How to verify the result: 0 full sort, 1 first k sorted, 2 median placed
+} BenchAlgorithm;
+
+static unsigned long long comparisons = 0;
+static char* topKOutput = NULL;
+
+// Comparison on the int32 key at the start of every record
+int cmpKey(void* a, void* b) {
+    int32_t x, y;
+    memcpy(&x, a, sizeof(x));
+    memcpy(&y, b, sizeof(y));
+    return (x > y) - (x < y);
+}
+
+// Same comparison, counting calls
+int cmpKeyCounted(void* a, void* b) {
+    comparisons++;
+    return cmpKey(a, b);
+}
+
+static int (*activeCmp)(void* a, void* b) = cmpKey;
+
+static int RunBubble(char* data, int n, int wide) { BubbleSort(data, n, wide, activeCmp); return 0; }
+static int RunPdq(char* data, int n, int wide) { PdqSort(data, n, wide, activeCmp); return 0; }
+static int RunStable(char* data, int n, int wide) { return StableSort(data, n, wide, activeCmp); }
+static int RunIndirect(char* data, int n, int wide) { return IndirectSort(data, n, wide, activeCmp); }
+static int RunParallel(char* data, int n, int wide) { ParallelSort(data, n, wide, cmpKey, 0, 0); return 0; }
+static int RunTyped(char* data, int n, int wide) { (void)wide; SortInt32((int32_t*)data, n); return 0; }
+static int RunRadix(char* data, int n, int wide) { return RadixSortRecords(data, n, wide, 0, 4, RADIX_KEY_SIGNED); }
+static int RunPartial(char* data, int n, int wide) { PartialSort(data, n, wide, activeCmp, BENCH_SELECT_K); return 0; }
+static int RunNth(char* data, int n, int wide) { NthElement(data, n, wide, activeCmp, n / 2); return 0; }
+
+// TopK writes to a side buffer; copy it back so the check sees the k smallest up front
+static int RunTopK(char* data, int n, int wide) {
+    int k = TopK(data, n, wide, activeCmp, topKOutput, BENCH_SELECT_K);
+    memcpy(data, topKOutput, (size_t)k * wide);
+    return 0;
+}
+
+// Round-trips the data through files in the working directory
+static int RunExternal(char* data, int n, int wide) {
+    const char* inPath = "benchmark_external_in.tmp";
+    const char* outPath = "benchmark_external_out.tmp";
+    FILE* f = fopen(inPath, "wb");
+    if (f == NULL || fwrite(data, (size_t)wide, (size_t)n, f) != (size_t)n) {
+        if (f != NULL) {
+            fclose(f);
+        }
+        return -1;
+    }
+    fclose(f);
+    // A budget of a quarter of the data forces several runs and a real merge.
+    size_t budget = (size_t)n * wide / 4;
+    if (budget < 4 * (size_t)EXTERNAL_SORT_MIN_BUFFER) {
+        budget = 4 * (size_t)EXTERNAL_SORT_MIN_BUFFER;
+    }
+    int status = ExternalSort(inPath, outPath, wide, activeCmp, budget);
+    f = fopen(outPath, "rb");
+    if (status != 0 || f == NULL || fread(data, (size_t)wide, (size_t)n, f) != (size_t)n) {
+        status = -1;
+    }
+    if (f != NULL) {
+        fclose(f);
+    }
+    remove(inPath);
+    remove(outPath);
+    return status;
+}
+
+static const BenchAlgorithm algorithms[] = {
+    { "BubbleSort", RunBubble, 10000, 0, 1, 0 },
+    { "PdqSort", RunPdq, 0, 0, 1, 0 },
+    { "StableSort", RunStable, 0, 0, 1, 0 },
+    { "IndirectSort", RunIndirect, 0, 0, 1, 0 },
+    { "ParallelSort", RunParallel, 0, 0, 2, 0 },
+    { "SortInt32", RunTyped, 0, 4, 0, 0 },
+    { "RadixSortRecords", RunRadix, 0, 0, 0, 0 },
+    { "ExternalSort", RunExternal, 1000000, 0, 1, 0 },
+    { "PartialSort", RunPartial, 0, 0, 1, 1 },
+    { "TopK", RunTopK, 0, 0, 1, 1 },
+    { "NthElement", RunNth, 0, 0, 1, 2 },
+};
+
+static const char* distributions[] = { "random", "sorted", "reverse", "few_unique", "organ_pipe", "nearly_sorted" };
+
+// Returns a timestamp in nanoseconds
+static double NowNs(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+// Simple xorshift generator so every run sorts the same data
+static uint64_t rngState = 88172645463325252ULL;
+static uint64_t NextRandom(void) {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 7;
+    rngState ^= rngState << 17;
+    return rngState;
+}
+
+// Fills n records of 'wide' bytes with keys following the given distribution
+static void Generate(char* data, int n, int wide, int distribution) {
+    for (int i = 0; i < n; i++) {
+        int32_t key;
+        switch (distribution) {
+        case 0: key = (int32_t)NextRandom(); break;
+        case 1: key = i; break;
+        case 2: key = n - i; break;
+        case 3: key = (int32_t)(NextRandom() % 16); break;
+        case 4: key = i < n / 2 ? i : n - i; break;
+        default: key = i; break;
+        }
+        char* record = data + (size_t)i * wide;
+        memcpy(record, &key, sizeof(key));
+        for (int b = (int)sizeof(key); b < wide; b++) {
+            record[b] = (char)(i + b);
+        }
+    }
+    if (distribution == 5) {
+        // Nearly sorted: swap 1% of the elements with a random partner.
+        SwapFunc swapElems = SelectSwap(wide);
+        for (int s = 0; s < n / 100 + 1 && n > 1; s++) {
+            int a = (int)(NextRandom() % (uint64_t)n);
+            int b = (int)(NextRandom() % (uint64_t)n);
+            swapElems(data + (size_t)a * wide, data + (size_t)b * wide, wide);
+        }
+    }
+}
+
+// Returns nonzero if the result satisfies the algorithm's postcondition
+static int Verify(const BenchAlgorithm* algorithm, char* data, const char* source, char* reference, int n, int wide) {
+    int upto = n;
+    if (algorithm->check == 1) {
+        upto = n < BENCH_SELECT_K ? n : BENCH_SELECT_K;
+    }
+    if (algorithm->check == 2) {
+        memcpy(reference, source, (size_t)n * wide);
+        PdqSort(reference, n, wide, cmpKey);
+        return n == 0 || cmpKey(data + (size_t)(n / 2) * wide, reference + (size_t)(n / 2) * wide) == 0;
+    }
+    if (algorithm->check == 1) {
+        memcpy(reference, source, (size_t)n * wide);
+        PartialSort(reference, n, wide, cmpKey, upto);
+        for (int i = 0; i < upto; i++) {
+            if (cmpKey(data + (size_t)i * wide, reference + (size_t)i * wide) != 0) {
+                return 0;
+            }
+        }
+        return 1;
+    }
+    for (int i = 1; i < upto; i++) {
+        if (cmpKey(data + (size_t)(i - 1) * wide, data + (size_t)i * wide) > 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+typedef struct {
+    int64_t key;
+    int64_t payload;
+} Record; ///< User key type used to show DEFINE_TYPED_SORT on a struct
+
+#define RECORD_LESS(a, b) ((a).key < (b).key)
+DEFINE_TYPED_SORT(static, SortRecords, Record, RECORD_LESS)
+
+// Comparison functions for the generic path of the --typed table
+int cmpInt64(void* a, void* b) {
+    int64_t x = *(int64_t*)a;
+    int64_t y = *(int64_t*)b;
+    return (x > y) - (x < y);
+}
+
+int cmpDouble(void* a, void* b) {
+    double x = *(double*)a;
+    double y = *(double*)b;
+    return (x > y) - (x < y);
+}
+
+int cmpRecord(void* a, void* b) {
+    return cmpInt64(&((Record*)a)->key, &((Record*)b)->key);
+}
+
+typedef void (*TypedSortFunc)(void* input, int sz); ///< Adapter type for the typed sorts
+
+static void TypedInt32(void* input, int sz) { SortInt32((int32_t*)input, sz); }
+static void TypedInt64(void* input, int sz) { SortInt64((int64_t*)input, sz); }
+static void TypedDouble(void* input, int sz) { SortDouble((double*)input, sz); }
+static void TypedRecord(void* input, int sz) { SortRecords((Record*)input, sz); }
+
+// Times the fastest of BENCH_TYPED_RUNS runs of either sort path over a fresh copy of 'source'
+static double TimeTypedSort(const void* source, void* work, int wide, int (*cmp)(void*, void*), TypedSortFunc typed) {
+    double best = 0;
+    for (int run = 0; run < BENCH_TYPED_RUNS; run++) {
+        memcpy(work, source, (size_t)BENCH_TYPED_SIZE * wide);
+        double start = NowNs();
+        if (typed != NULL) {
+            typed(work, BENCH_TYPED_SIZE);
+        }
+        else {
+            PdqSort(work, BENCH_TYPED_SIZE, wide, cmp);
+        }
+        double elapsed = NowNs() - start;
+        if (run == 0 || elapsed < best) {
+            best = elapsed;
+        }
+    }
+    return best / BENCH_TYPED_SIZE;
+}
+
+// Prints the generic-vs-typed table
+static int RunTypedComparison(void) {
+    const char* names[] = { "int32", "int64", "double", "record16" };
+    int widths[] = { sizeof(int32_t), sizeof(int64_t), sizeof(double), sizeof(Record) };
+    int (*cmps[])(void*, void*) = { cmpKey, cmpInt64, cmpDouble, cmpRecord };
+    TypedSortFunc typed[] = { TypedInt32, TypedInt64, TypedDouble, TypedRecord };
+
+    char* source = (char*)malloc((size_t)BENCH_TYPED_SIZE * sizeof(Record));
+    char* work = (char*)malloc((size_t)BENCH_TYPED_SIZE * sizeof(Record));
+    if (source == NULL || work == NULL) {
+        printf("Memory allocation failed\n");
+        free(source);
+        free(work);
+        return 1;
+    }
+
+    printf("%-10s %14s %14s %8s\n", "type", "generic ns/el", "typed ns/el", "speedup");
+    for (int t = 0; t < 4; t++) {
+        for (int i = 0; i < BENCH_TYPED_SIZE; i++) {
+            uint64_t r = NextRandom();
+            switch (t) {
+            case 0: ((int32_t*)source)[i] = (int32_t)r; break;
+            case 1: ((int64_t*)source)[i] = (int64_t)r; break;
+            case 2: ((double*)source)[i] = (double)(r >> 11) / 9007199254740992.0; break;
+            default: ((Record*)source)[i].key = (int64_t)r; ((Record*)source)[i].payload = i; break;
+            }
+        }
+        double generic = TimeTypedSort(source, work, widths[t], cmps[t], NULL);
+        double specialized = TimeTypedSort(source, work, widths[t], NULL, typed[t]);
+        printf("%-10s %14.2f %14.2f %7.2fx\n", names[t], generic, specialized, generic / specialized);
+    }
+
+    free(source);
+    free(work);
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--typed") == 0) {
+        return RunTypedComparison();
+    }
+    int maxSize = argc > 1 ? atoi(argv[1]) : BENCH_DEFAULT_MAX_SIZE;
+    FILE* out = argc > 2 ? fopen(argv[2], "w") : stdout;
+    if (maxSize < 10 || out == NULL) {
+        printf("Usage: %s [maxSize >= 10] [output.csv] | --typed\n", argv[0]);
+        return 1;
+    }
+    int widths[] = { 4, 8, 16, 64, 256 };
+    int algorithmCount = (int)(sizeof(algorithms) / sizeof(algorithms[0]));
+
+    fprintf(out, "algorithm,distribution,size,width,ns_per_element,comparisons,swaps\n");
+    for (int n = 10; n <= maxSize; n *= 10) {
+        for (int wi = 0; wi < 5; wi++) {
+            int wide = widths[wi];
+            size_t bytes = (size_t)n * wide;
+            if (bytes > BENCH_MAX_BYTES) {
+                continue;
+            }
+            char* source = (char*)malloc(bytes);
+            char* data = (char*)malloc(bytes);
+            char* reference = (char*)malloc(bytes);
+            topKOutput = (char*)malloc((size_t)BENCH_SELECT_K * wide);
+            if (source == NULL || data == NULL || reference == NULL || topKOutput == NULL) {
+                printf("Memory allocation failed for size %d, width %d\n", n, wide);
+                free(source);
+                free(data);
+                free(reference);
+                free(topKOutput);
+                continue;
+            }
+            for (int d = 0; d < 6; d++) {
+                Generate(source, n, wide, d);
+                for (int a = 0; a < algorithmCount; a++) {
+                    const BenchAlgorithm* algorithm = &algorithms[a];
+                    if ((algorithm->maxSize && n > algorithm->maxSize)
+                        || (algorithm->onlyWide && wide != algorithm->onlyWide)) {
+                        continue;
+                    }
+
+                    // Timed runs with the plain comparison function
+                    int reps = BENCH_TARGET_ELEMENTS / n;
+                    if (reps < 1 || algorithm->maxSize) {
+                        reps = 1;
+                    }
+                    double elapsed = 0;
+                    activeCmp = cmpKey;
+                    for (int r = 0; r < reps; r++) {
+                        memcpy(data, source, bytes);
+                        double start = NowNs();
+                        int failed = algorithm->run(data, n, wide);
+                        elapsed += NowNs() - start;
+                        if (failed || !Verify(algorithm, data, source, reference, n, wide)) {
+                            printf("%s failed on %s data (size %d, width %d)\n", algorithm->name, distributions[d], n, wide);
+                            return 1;
+                        }
+                    }
+
+                    // One counted run
+                    long long cmpCount = -1;
+                    long long swapCount = -1;
+                    if (algorithm->counted) {
+                        memcpy(data, source, bytes);
+                        activeCmp = cmpKeyCounted;
+                        comparisons = 0;
+#ifdef SORT_STATS
+                        SortSwapCount = 0;
+#endif
+                        algorithm->run(data, n, wide);
+                        if (algorithm->counted == 1) {
+                            cmpCount = (long long)comparisons;
+                        }
+#ifdef SORT_STATS
+                        swapCount = (long long)SortSwapCount;
+#endif
+                    }
+
+                    fprintf(out, "%s,%s,%d,%d,%.3f,%lld,%lld\n", algorithm->name, distributions[d], n, wide,
+                        elapsed / reps / n, cmpCount, swapCount);
+                    fflush(out);
+                }
+            }
+            free(source);
+            free(data);
+            free(reference);
+            free(topKOutput);
+        }
+    }
+    if (out != stdout) {
+        fclose(out);
+    }
+    return 0;
+}
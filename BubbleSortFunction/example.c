@@ -33,5 +33,13 @@ int main() {
     }
     printf("\n"); // Print a newline at the end
 
+    // Sort a fresh copy of the reversed array with PdqSort
+    int arr2[10] = { 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 };
+    PdqSort(arr2, 10, sizeof(int), cmp);
+    for (int i = 0; i < 10; i++) {
+        printf("%d ", arr2[i]);
+    }
+    printf("\n");
+
     return 0; // Return success
 }
\ No newline at end of file
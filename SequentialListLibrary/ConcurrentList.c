@@ -0,0 +1,396 @@
+#include "ConcurrentList.h"
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Allocates a snapshot header for 'length' elements of 'elem'.
+ */
+static ListSnapshot* NewSnapshot(const ElemType* elem, int length) {
+    ListSnapshot* snap = (ListSnapshot*)malloc(sizeof(ListSnapshot));
+    if (snap != NULL) {
+        snap->elem = elem;
+        snap->length = length;
+        snap->nextRetired = NULL;
+        snap->retireEpoch = 0;
+        snap->ownedBuffer = NULL;
+    }
+    return snap;
+}
+
+/**
+ * @brief Initializes an empty concurrent list.
+ *
+ * @param C Pointer to the list.
+ * @param capacity Initial buffer capacity (LIST_INIT_SIZE if less than 1).
+ * @return LIST_OK on success, LIST_ERR_NOMEM if an allocation failed.
+ */
+int InitConcurrentList(ConcurrentList* C, int capacity) {
+    if (capacity < 1) {
+        capacity = LIST_INIT_SIZE;
+    }
+    C->buffer = (ElemType*)malloc((size_t)capacity * sizeof(ElemType));
+    ListSnapshot* snap = C->buffer != NULL ? NewSnapshot(C->buffer, 0) : NULL;
+    if (snap == NULL) {
+        free(C->buffer);
+        C->buffer = NULL;
+        return LIST_ERR_NOMEM;
+    }
+    atomic_init(&C->current, snap);
+    atomic_init(&C->epoch, 1);
+    pthread_mutex_init(&C->writeLock, NULL);
+    C->capacity = capacity;
+    C->highWater = 0;
+    C->retiredHead = NULL;
+    C->retiredTail = NULL;
+    C->retiredCount = 0;
+    for (int r = 0; r < CONCURRENT_LIST_MAX_READERS; r++) {
+        atomic_init(&C->readers[r].epoch, 0);
+        atomic_init(&C->readers[r].inUse, 0);
+    }
+    return LIST_OK;
+}
+
+/**
+ * @brief Frees a retired snapshot and the buffer it owns, if any.
+ */
+static void FreeSnapshot(ListSnapshot* snap) {
+    free(snap->ownedBuffer);
+    free(snap);
+}
+
+/**
+ * @brief Frees the list and every snapshot. No thread may be using the list.
+ *
+ * @param C Pointer to the list.
+ */
+void DestroyConcurrentList(ConcurrentList* C) {
+    while (C->retiredHead != NULL) {
+        ListSnapshot* next = C->retiredHead->nextRetired;
+        FreeSnapshot(C->retiredHead);
+        C->retiredHead = next;
+    }
+    C->retiredTail = NULL;
+    C->retiredCount = 0;
+    free(atomic_load(&C->current));
+    atomic_store(&C->current, NULL);
+    free(C->buffer);
+    C->buffer = NULL;
+    C->capacity = 0;
+    pthread_mutex_destroy(&C->writeLock);
+}
+
+/**
+ * @brief Claims a reader slot for the calling thread.
+ *
+ * @param C Pointer to the list.
+ * @return The slot number, or LIST_ERR_FULL if all slots are taken.
+ */
+int ConcurrentListRegister(ConcurrentList* C) {
+    for (int r = 0; r < CONCURRENT_LIST_MAX_READERS; r++) {
+        int expected = 0;
+        if (atomic_compare_exchange_strong(&C->readers[r].inUse, &expected, 1)) {
+            return r;
+        }
+    }
+    return LIST_ERR_FULL;
+}
+
+/**
+ * @brief Releases a reader slot.
+ *
+ * @param C Pointer to the list.
+ * @param reader Slot number returned by ConcurrentListRegister.
+ */
+void ConcurrentListUnregister(ConcurrentList* C, int reader) {
+    atomic_store(&C->readers[reader].epoch, 0);
+    atomic_store(&C->readers[reader].inUse, 0);
+}
+
+/**
+ * @brief Enters a read section and returns the current snapshot.
+ *
+ * The reader announces the global epoch before loading the snapshot
+ * pointer (both sequentially consistent). A writer that retires this
+ * snapshot afterwards tags it with an epoch at least as large, so it
+ * cannot be freed while the reader's announcement is visible; and if the
+ * writer's scan missed the announcement, the load below already returns
+ * the replacement.
+ *
+ * @param C Pointer to the list.
+ * @param reader Slot number of the calling thread.
+ * @return The current snapshot.
+ */
+const ListSnapshot* ConcurrentListReadBegin(ConcurrentList* C, int reader) {
+    atomic_store(&C->readers[reader].epoch, atomic_load(&C->epoch));
+    return atomic_load(&C->current);
+}
+
+/**
+ * @brief Leaves a read section.
+ *
+ * @param C Pointer to the list.
+ * @param reader Slot number of the calling thread.
+ */
+void ConcurrentListReadEnd(ConcurrentList* C, int reader) {
+    atomic_store_explicit(&C->readers[reader].epoch, 0, memory_order_release);
+}
+
+/**
+ * @brief Returns the number of elements, without locking.
+ *
+ * @param C Pointer to the list.
+ * @param reader Slot number of the calling thread.
+ * @return The length of the current snapshot.
+ */
+int ConcurrentListLength(ConcurrentList* C, int reader) {
+    int length = ConcurrentListReadBegin(C, reader)->length;
+    ConcurrentListReadEnd(C, reader);
+    return length;
+}
+
+/**
+ * @brief Retrieves the element at the specified position, without locking.
+ *
+ * @param C Pointer to the list.
+ * @param reader Slot number of the calling thread.
+ * @param i The position (1-based index) of the element to retrieve.
+ * @param result Pointer to store the element if found.
+ * @return LIST_OK on success, LIST_ERR_POSITION if the position is invalid.
+ */
+int ConcurrentOrderNum(ConcurrentList* C, int reader, int i, ElemType* result) {
+    const ListSnapshot* snap = ConcurrentListReadBegin(C, reader);
+    int status = LIST_ERR_POSITION;
+    if (i >= 1 && i <= snap->length) {
+        *result = snap->elem[i - 1];
+        status = LIST_OK;
+    }
+    ConcurrentListReadEnd(C, reader);
+    return status;
+}
+
+/**
+ * @brief Locates an element, without locking.
+ *
+ * Scans the snapshot with LocateElem through a read-only SqList view, so
+ * the vectorized scan kernels are used. Their first-call selection is
+ * atomic, so any number of readers may be the first caller. Like
+ * LocateElem, a miss is reported to the log hook from the reading thread;
+ * a hook installed with SetListLogHook must be thread-safe.
+ *
+ * @param C Pointer to the list.
+ * @param reader Slot number of the calling thread.
+ * @param e The element to locate.
+ * @return The position (1-based index) of the first element equal to 'e', or 0 if not found.
+ */
+int ConcurrentLocateElem(ConcurrentList* C, int reader, ElemType e) {
+    const ListSnapshot* snap = ConcurrentListReadBegin(C, reader);
+    SqList view;
+    view.elem = (ElemType*)snap->elem;
+    view.length = snap->length;
+    view.listsize = snap->length;
+    view.index = NULL;
+    view.allocator = NULL;
+    int pos = LocateElem(&view, e);
+    ConcurrentListReadEnd(C, reader);
+    return pos;
+}
+
+/**
+ * @brief Frees retired snapshots that no active reader can still hold.
+ *
+ * Snapshots are retired in epoch order, so freeing stops at the first one
+ * tagged with an epoch some active reader has not moved past. Called with
+ * the write lock held.
+ */
+static void Reclaim(ConcurrentList* C) {
+    unsigned long oldest = ULONG_MAX;
+    for (int r = 0; r < CONCURRENT_LIST_MAX_READERS; r++) {
+        unsigned long e = atomic_load(&C->readers[r].epoch);
+        if (e != 0 && e < oldest) {
+            oldest = e;
+        }
+    }
+    while (C->retiredHead != NULL && C->retiredHead->retireEpoch < oldest) {
+        ListSnapshot* next = C->retiredHead->nextRetired;
+        FreeSnapshot(C->retiredHead);
+        C->retiredHead = next;
+        C->retiredCount--;
+    }
+    if (C->retiredHead == NULL) {
+        C->retiredTail = NULL;
+    }
+}
+
+/**
+ * @brief Installs 'snap' as the current snapshot and retires the old one.
+ *
+ * Called with the write lock held.
+ *
+ * @param C Pointer to the list.
+ * @param snap The new snapshot.
+ * @param abandoned The buffer the list no longer uses (freed with the old snapshot), or NULL.
+ */
+static void Publish(ConcurrentList* C, ListSnapshot* snap, ElemType* abandoned) {
+    ListSnapshot* old = atomic_exchange(&C->current, snap);
+    old->ownedBuffer = abandoned;
+    old->retireEpoch = atomic_fetch_add(&C->epoch, 1);
+    if (C->retiredTail != NULL) {
+        C->retiredTail->nextRetired = old;
+    }
+    else {
+        C->retiredHead = old;
+    }
+    C->retiredTail = old;
+    if (++C->retiredCount >= CONCURRENT_LIST_RECLAIM_BATCH) {
+        Reclaim(C);
+    }
+}
+
+/**
+ * @brief Returns the capacity to allocate for 'needed' elements, growing geometrically.
+ */
+static int CopyCapacity(const ConcurrentList* C, int needed) {
+    if (needed <= C->capacity) {
+        return C->capacity;
+    }
+    int grown = ListGrowCapacity(C->capacity);
+    return grown > needed ? grown : needed;
+}
+
+/**
+ * @brief Publishes a copy of the current snapshot with 'e' inserted at 0-based 'k', or element 'k' removed.
+ *
+ * Called with the write lock held.
+ *
+ * @param C Pointer to the list.
+ * @param cur The current snapshot.
+ * @param k The 0-based position of the change.
+ * @param insert Nonzero to insert 'e' at 'k', zero to delete element 'k'.
+ * @param e The element to insert.
+ * @return LIST_OK on success, LIST_ERR_NOMEM otherwise.
+ */
+static int PublishCopy(ConcurrentList* C, const ListSnapshot* cur, int k, int insert, ElemType e) {
+    int n = cur->length;
+    int length = insert ? n + 1 : n - 1;
+    int capacity = CopyCapacity(C, length);
+    ElemType* buffer = (ElemType*)malloc((size_t)capacity * sizeof(ElemType));
+    ListSnapshot* snap = buffer != NULL ? NewSnapshot(buffer, length) : NULL;
+    if (snap == NULL) {
+        free(buffer);
+        return LIST_ERR_NOMEM;
+    }
+    memcpy(buffer, cur->elem, (size_t)k * sizeof(ElemType));
+    if (insert) {
+        buffer[k] = e;
+        memcpy(buffer + k + 1, cur->elem + k, (size_t)(n - k) * sizeof(ElemType));
+    }
+    else {
+        memcpy(buffer + k, cur->elem + k + 1, (size_t)(n - k - 1) * sizeof(ElemType));
+    }
+    ElemType* abandoned = C->buffer;
+    C->buffer = buffer;
+    C->capacity = capacity;
+    C->highWater = length;
+    Publish(C, snap, abandoned);
+    return LIST_OK;
+}
+
+/**
+ * @brief Appends an element, with the write lock held.
+ */
+static int AppendLocked(ConcurrentList* C, ElemType e) {
+    ListSnapshot* cur = atomic_load_explicit(&C->current, memory_order_relaxed);
+    int n = cur->length;
+    if (n == INT_MAX) {
+        return LIST_ERR_FULL;
+    }
+    // Slot n was never part of a published snapshot, so no reader can see the write.
+    if (n == C->highWater && n < C->capacity) {
+        ListSnapshot* snap = NewSnapshot(C->buffer, n + 1);
+        if (snap == NULL) {
+            return LIST_ERR_NOMEM;
+        }
+        C->buffer[n] = e;
+        C->highWater = n + 1;
+        Publish(C, snap, NULL);
+        return LIST_OK;
+    }
+    return PublishCopy(C, cur, n, 1, e);
+}
+
+/**
+ * @brief Appends an element. O(1) amortized while the buffer has room.
+ *
+ * @param C Pointer to the list.
+ * @param e The element to be appended.
+ * @return LIST_OK on success, LIST_ERR_FULL or LIST_ERR_NOMEM if the list could not grow.
+ */
+int ConcurrentListAppend(ConcurrentList* C, ElemType e) {
+    pthread_mutex_lock(&C->writeLock);
+    int status = AppendLocked(C, e);
+    pthread_mutex_unlock(&C->writeLock);
+    return status;
+}
+
+/**
+ * @brief Inserts an element at the specified position.
+ *
+ * Insertion at the end is an append; anywhere else the buffer is copied
+ * with the new element in place.
+ *
+ * @param C Pointer to the list.
+ * @param i The position (1-based index) at which to insert the element.
+ * @param e The element to be inserted.
+ * @return LIST_OK on success, LIST_ERR_POSITION if 'i' is out of range,
+ *         LIST_ERR_FULL or LIST_ERR_NOMEM if the list could not grow.
+ */
+int ConcurrentListInsert(ConcurrentList* C, int i, ElemType e) {
+    pthread_mutex_lock(&C->writeLock);
+    ListSnapshot* cur = atomic_load_explicit(&C->current, memory_order_relaxed);
+    int status;
+    if (i < 1 || i > cur->length + 1) {
+        status = LIST_ERR_POSITION;
+    }
+    else if (i == cur->length + 1) {
+        status = AppendLocked(C, e);
+    }
+    else {
+        status = PublishCopy(C, cur, i - 1, 1, e);
+    }
+    pthread_mutex_unlock(&C->writeLock);
+    return status;
+}
+
+/**
+ * @brief Deletes the element at the specified position.
+ *
+ * Deleting the last element only publishes a shorter snapshot of the same
+ * buffer; anywhere else the buffer is copied without the element.
+ *
+ * @param C Pointer to the list.
+ * @param i The position (1-based index) of the element to delete.
+ * @return LIST_OK on success, LIST_ERR_POSITION if 'i' is out of range,
+ *         LIST_ERR_NOMEM if the copy could not be allocated.
+ */
+int ConcurrentListDelete(ConcurrentList* C, int i) {
+    pthread_mutex_lock(&C->writeLock);
+    ListSnapshot* cur = atomic_load_explicit(&C->current, memory_order_relaxed);
+    int status;
+    if (i < 1 || i > cur->length) {
+        status = LIST_ERR_POSITION;
+    }
+    else if (i == cur->length) {
+        ListSnapshot* snap = NewSnapshot(C->buffer, i - 1);
+        status = LIST_ERR_NOMEM;
+        if (snap != NULL) {
+            Publish(C, snap, NULL);
+            status = LIST_OK;
+        }
+    }
+    else {
+        status = PublishCopy(C, cur, i - 1, 0, 0);
+    }
+    pthread_mutex_unlock(&C->writeLock);
+    return status;
+}
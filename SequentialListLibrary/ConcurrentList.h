@@ -0,0 +1,180 @@
+#ifndef XPERANCE_CONCURRENTLIST
+#define XPERANCE_CONCURRENTLIST
+
+#include "SqList.h"
+#include <pthread.h>
+#include <stdatomic.h>
+
+/*
+ * Sequential list shared between threads.
+ *
+ * Readers never lock. They work on an immutable snapshot of the list: the
+ * current snapshot is published through an atomic pointer, and every
+ * change installs a new one. Writers serialize on a mutex. Appends that
+ * fit the current buffer write past the end of every published snapshot
+ * and share the buffer; other changes copy it (copy-on-write). A replaced
+ * snapshot, and its buffer once no snapshot uses it, is freed by
+ * epoch-based reclamation: it is retired with the epoch current at the
+ * time and freed once every active reader has entered a later epoch.
+ *
+ * Each reading thread registers once to obtain a reader slot and passes
+ * its slot number to the read functions.
+ */
+
+#define CONCURRENT_LIST_MAX_READERS 64 ///< Reader slots per list
+#define CONCURRENT_LIST_RECLAIM_BATCH 32 ///< Retired snapshots collected before a writer tries to free them
+
+/**
+ * @brief An immutable view of the list.
+ *
+ * @elem The elements; must not be modified.
+ * @length Number of elements in this snapshot.
+ */
+typedef struct ListSnapshot {
+    const ElemType* elem; ///< Elements of the snapshot (read-only)
+    int length; ///< Number of elements in the snapshot
+    struct ListSnapshot* nextRetired; ///< Next snapshot in the retired list
+    unsigned long retireEpoch; ///< Epoch in which the snapshot was replaced
+    ElemType* ownedBuffer; ///< Buffer to free together with this snapshot, or NULL
+} ListSnapshot;
+
+/**
+ * @brief Per-reader state, on its own cache line to avoid false sharing.
+ */
+typedef struct {
+    _Alignas(64) atomic_ulong epoch; ///< Epoch seen on entering a read section, 0 outside one
+    atomic_int inUse; ///< Nonzero while the slot is registered
+} ListReaderSlot;
+
+/**
+ * @brief The structure representing a concurrent list.
+ */
+typedef struct {
+    _Atomic(ListSnapshot*) current; ///< Snapshot readers see
+    atomic_ulong epoch; ///< Global epoch, advanced each time a snapshot is retired
+    pthread_mutex_t writeLock; ///< Serializes writers and reclamation
+    ElemType* buffer; ///< Buffer of the current snapshot (writer state)
+    int capacity; ///< Capacity of 'buffer'
+    int highWater; ///< Largest length ever published on 'buffer'; slots below it may be read
+    ListSnapshot* retiredHead; ///< Oldest retired snapshot
+    ListSnapshot* retiredTail; ///< Newest retired snapshot
+    int retiredCount; ///< Snapshots waiting to be freed
+    ListReaderSlot readers[CONCURRENT_LIST_MAX_READERS]; ///< Reader registry
+} ConcurrentList;
+
+/**
+ * @brief Initializes an empty concurrent list.
+ *
+ * @param C Pointer to the list.
+ * @param capacity Initial buffer capacity (LIST_INIT_SIZE if less than 1).
+ * @return LIST_OK on success, LIST_ERR_NOMEM if an allocation failed.
+ */
+int InitConcurrentList(ConcurrentList* C, int capacity);
+
+/**
+ * @brief Frees the list and every snapshot. No thread may be using the list.
+ *
+ * @param C Pointer to the list.
+ */
+void DestroyConcurrentList(ConcurrentList* C);
+
+/**
+ * @brief Claims a reader slot for the calling thread.
+ *
+ * @param C Pointer to the list.
+ * @return The slot number, or LIST_ERR_FULL if all CONCURRENT_LIST_MAX_READERS slots are taken.
+ */
+int ConcurrentListRegister(ConcurrentList* C);
+
+/**
+ * @brief Releases a reader slot. The reader must not be inside a read section.
+ *
+ * @param C Pointer to the list.
+ * @param reader Slot number returned by ConcurrentListRegister.
+ */
+void ConcurrentListUnregister(ConcurrentList* C, int reader);
+
+/**
+ * @brief Enters a read section and returns the current snapshot.
+ *
+ * The snapshot stays valid, and unchanged, until ConcurrentListReadEnd.
+ * Read sections should be short: they hold back reclamation.
+ *
+ * @param C Pointer to the list.
+ * @param reader Slot number of the calling thread.
+ * @return The current snapshot.
+ */
+const ListSnapshot* ConcurrentListReadBegin(ConcurrentList* C, int reader);
+
+/**
+ * @brief Leaves a read section.
+ *
+ * @param C Pointer to the list.
+ * @param reader Slot number of the calling thread.
+ */
+void ConcurrentListReadEnd(ConcurrentList* C, int reader);
+
+/**
+ * @brief Returns the number of elements, without locking.
+ *
+ * @param C Pointer to the list.
+ * @param reader Slot number of the calling thread.
+ * @return The length of the current snapshot.
+ */
+int ConcurrentListLength(ConcurrentList* C, int reader);
+
+/**
+ * @brief Retrieves the element at the specified position, without locking.
+ *
+ * @param C Pointer to the list.
+ * @param reader Slot number of the calling thread.
+ * @param i The position (1-based index) of the element to retrieve.
+ * @param result Pointer to store the element if found.
+ * @return LIST_OK on success, LIST_ERR_POSITION if the position is invalid.
+ */
+int ConcurrentOrderNum(ConcurrentList* C, int reader, int i, ElemType* result);
+
+/**
+ * @brief Locates an element, without locking.
+ *
+ * Like LocateElem, a miss is reported to the log hook, here from the
+ * reading thread; a hook installed with SetListLogHook must be thread-safe.
+ *
+ * @param C Pointer to the list.
+ * @param reader Slot number of the calling thread.
+ * @param e The element to locate.
+ * @return The position (1-based index) of the first element equal to 'e', or 0 if not found.
+ */
+int ConcurrentLocateElem(ConcurrentList* C, int reader, ElemType e);
+
+/**
+ * @brief Appends an element. O(1) amortized while the buffer has room.
+ *
+ * @param C Pointer to the list.
+ * @param e The element to be appended.
+ * @return LIST_OK on success, LIST_ERR_FULL or LIST_ERR_NOMEM if the list could not grow.
+ */
+int ConcurrentListAppend(ConcurrentList* C, ElemType e);
+
+/**
+ * @brief Inserts an element at the specified position (copies the buffer unless appending).
+ *
+ * @param C Pointer to the list.
+ * @param i The position (1-based index) at which to insert the element.
+ * @param e The element to be inserted.
+ * @return LIST_OK on success, LIST_ERR_POSITION if 'i' is out of range,
+ *         LIST_ERR_FULL or LIST_ERR_NOMEM if the list could not grow.
+ */
+int ConcurrentListInsert(ConcurrentList* C, int i, ElemType e);
+
+/**
+ * @brief Deletes the element at the specified position (copies the buffer unless it is the last).
+ *
+ * @param C Pointer to the list.
+ * @param i The position (1-based index) of the element to delete.
+ * @return LIST_OK on success, LIST_ERR_POSITION if 'i' is out of range,
+ *         LIST_ERR_NOMEM if the copy could not be allocated.
+ */
+int ConcurrentListDelete(ConcurrentList* C, int i);
+
+#endif
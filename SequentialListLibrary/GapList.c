@@ -0,0 +1,223 @@
+#include "GapList.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Initializes an empty gap list.
+ *
+ * @param G Pointer to the list to be initialized.
+ * @param capacity Number of elements to allocate up front (LIST_INIT_SIZE if less than 1).
+ * @return LIST_OK on success, LIST_ERR_NOMEM if the allocation failed.
+ */
+int InitGapList(GapList* G, int capacity) {
+    if (capacity < 1) {
+        capacity = LIST_INIT_SIZE;
+    }
+    G->gapStart = 0;
+    G->elem = (ElemType*)malloc((size_t)capacity * sizeof(ElemType));
+    if (!G->elem) {
+        G->gapEnd = 0;
+        G->listsize = 0;
+        return LIST_ERR_NOMEM;
+    }
+    G->gapEnd = capacity;
+    G->listsize = capacity;
+    return LIST_OK;
+}
+
+/**
+ * @brief Destroys the gap list and releases its memory.
+ *
+ * @param G Pointer to the list to be destroyed.
+ */
+void DestroyGapList(GapList* G) {
+    free(G->elem);
+    G->elem = NULL;
+    G->gapStart = 0;
+    G->gapEnd = 0;
+    G->listsize = 0;
+}
+
+/**
+ * @brief Returns the number of elements in the gap list.
+ *
+ * @param G Pointer to the list.
+ * @return The number of elements.
+ */
+int GapListLength(GapList* G) {
+    return G->listsize - (G->gapEnd - G->gapStart);
+}
+
+/**
+ * @brief Retrieves the element at the specified position.
+ *
+ * @param G Pointer to the list.
+ * @param i The position (1-based index) of the element to retrieve.
+ * @param result Pointer to store the element if found.
+ * @return LIST_OK on success, LIST_ERR_POSITION if the position is invalid.
+ */
+int GapOrderNum(GapList* G, int i, ElemType* result) {
+    if (i < 1 || i > GapListLength(G)) {
+        return LIST_ERR_POSITION;
+    }
+    int k = i - 1;
+    *result = G->elem[k < G->gapStart ? k : k + (G->gapEnd - G->gapStart)];
+    return LIST_OK;
+}
+
+/**
+ * @brief Moves the gap so that it starts at index 'k' (the number of elements before it).
+ *
+ * Only the elements between the old and the new gap position move.
+ *
+ * @param G Pointer to the list.
+ * @param k The new gap start, 0 <= k <= length.
+ */
+static void MoveGap(GapList* G, int k) {
+    int gap = G->gapEnd - G->gapStart;
+    if (k < G->gapStart) {
+        // Elements [k, gapStart) move up behind the gap.
+        int count = G->gapStart - k;
+        memmove(G->elem + k + gap, G->elem + k, (size_t)count * sizeof(ElemType));
+    }
+    else if (k > G->gapStart) {
+        // Elements [gapEnd, gapEnd + count) move down in front of the gap.
+        int count = k - G->gapStart;
+        memmove(G->elem + G->gapStart, G->elem + G->gapEnd, (size_t)count * sizeof(ElemType));
+    }
+    G->gapStart = k;
+    G->gapEnd = k + gap;
+}
+
+/**
+ * @brief Enlarges the array geometrically when the gap is full.
+ *
+ * The elements after the gap move to the end of the new array, so the gap
+ * absorbs all of the new capacity.
+ *
+ * @param G Pointer to the list.
+ * @return LIST_OK on success, LIST_ERR_FULL or LIST_ERR_NOMEM otherwise.
+ */
+static int GrowGap(GapList* G) {
+    int newsize = ListGrowCapacity(G->listsize);
+    if (newsize <= G->listsize) {
+        return LIST_ERR_FULL;
+    }
+    ElemType* newbase = (ElemType*)realloc(G->elem, (size_t)newsize * sizeof(ElemType));
+    if (!newbase) {
+        return LIST_ERR_NOMEM;
+    }
+    int tail = G->listsize - G->gapEnd;
+    memmove(newbase + newsize - tail, newbase + G->gapEnd, (size_t)tail * sizeof(ElemType));
+    G->elem = newbase;
+    G->gapEnd = newsize - tail;
+    G->listsize = newsize;
+    return LIST_OK;
+}
+
+/**
+ * @brief Returns excess capacity once the list is mostly gap.
+ *
+ * Follows ListShrinkCapacity, so a GapList shrinks at the same occupancy
+ * as a SqList. The elements after the gap move down to the end of the
+ * smaller array before it is reallocated.
+ *
+ * @param G Pointer to the list.
+ */
+static void ShrinkGap(GapList* G) {
+    int newsize = ListShrinkCapacity(GapListLength(G), G->listsize);
+    if (newsize == G->listsize) {
+        return;
+    }
+    int tail = G->listsize - G->gapEnd;
+    memmove(G->elem + newsize - tail, G->elem + G->gapEnd, (size_t)tail * sizeof(ElemType));
+    ElemType* newbase = (ElemType*)realloc(G->elem, (size_t)newsize * sizeof(ElemType));
+    if (newbase) {
+        G->elem = newbase;
+    }
+    // If realloc failed the old, larger block still holds the new layout.
+    G->gapEnd = newsize - tail;
+    G->listsize = newsize;
+}
+
+/**
+ * @brief Inserts an element at the specified position.
+ *
+ * Moves the gap to the insertion point and writes the element into its
+ * first slot, so consecutive inserts at a cursor cost O(1) each.
+ *
+ * @param G Pointer to the list.
+ * @param i The position (1-based index) at which to insert the element.
+ * @param e The element to be inserted.
+ * @return LIST_OK on success, LIST_ERR_POSITION if 'i' is out of range,
+ *         LIST_ERR_FULL or LIST_ERR_NOMEM if the list could not grow.
+ */
+int GapListInsert(GapList* G, int i, ElemType e) {
+    if (i < 1 || i > GapListLength(G) + 1) {
+        return LIST_ERR_POSITION;
+    }
+    if (G->gapStart == G->gapEnd) {
+        int status = GrowGap(G);
+        if (status != LIST_OK) {
+            return status;
+        }
+    }
+    MoveGap(G, i - 1);
+    G->elem[G->gapStart++] = e;
+    return LIST_OK;
+}
+
+/**
+ * @brief Deletes the element at the specified position.
+ *
+ * Moves the gap next to the element and widens the gap over it, then
+ * shrinks the array if it has become mostly gap (see ListShrinkCapacity).
+ *
+ * @param G Pointer to the list.
+ * @param i The position (1-based index) of the element to delete.
+ * @return LIST_OK on success, LIST_ERR_POSITION if 'i' is out of range.
+ */
+int GapListDelete(GapList* G, int i) {
+    if (i < 1 || i > GapListLength(G)) {
+        return LIST_ERR_POSITION;
+    }
+    MoveGap(G, i - 1);
+    G->gapEnd++;
+    ShrinkGap(G);
+    return LIST_OK;
+}
+
+/**
+ * @brief Locates an element and returns its position.
+ *
+ * Scans the part before the gap, then the part after it.
+ *
+ * @param G Pointer to the list.
+ * @param e The element to locate.
+ * @return The position (1-based index) of the first element equal to 'e', or 0 if not found.
+ */
+int GapLocateElem(GapList* G, ElemType e) {
+    for (int k = 0; k < G->gapStart; k++) {
+        if (G->elem[k] == e) {
+            return k + 1;
+        }
+    }
+    int gap = G->gapEnd - G->gapStart;
+    for (int k = G->gapEnd; k < G->listsize; k++) {
+        if (G->elem[k] == e) {
+            return k - gap + 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Moves the gap to the end so that all elements are contiguous.
+ *
+ * @param G Pointer to the list.
+ * @return Pointer to the first of GapListLength(G) contiguous elements; valid until the next edit.
+ */
+const ElemType* GapListCompact(GapList* G) {
+    MoveGap(G, GapListLength(G));
+    return G->elem;
+}
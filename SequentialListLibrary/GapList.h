@@ -0,0 +1,109 @@
+#ifndef XPERANCE_GAPLIST
+#define XPERANCE_GAPLIST
+
+#include "SqList.h"
+
+/*
+ * Gap buffer storage for workloads that edit around a cursor.
+ *
+ * The elements live in one array with a movable gap of free slots. An
+ * insertion or deletion first moves the gap to the edit position, which
+ * costs only the distance from the previous edit, then fills or widens the
+ * gap in O(1). Edits that stay near each other are therefore O(1) instead
+ * of shifting the whole tail as ListInsert/ListDelete do. The functions
+ * mirror the position-based SqList API: positions are 1-based and the
+ * LIST_* status codes are returned.
+ */
+
+/**
+ * @brief The structure representing a gap buffer list.
+ *
+ * @elem Element array; slots [gapStart, gapEnd) are unused.
+ * @gapStart Index of the first slot of the gap.
+ * @gapEnd Index just past the last slot of the gap.
+ * @listsize Allocated capacity of the array.
+ */
+typedef struct {
+    ElemType* elem; ///< Element array with a gap in [gapStart, gapEnd)
+    int gapStart; ///< Index of the first unused slot; equals the number of elements before the gap
+    int gapEnd; ///< Index just past the last unused slot
+    int listsize; ///< Allocated capacity of the array
+} GapList;
+
+/**
+ * @brief Initializes an empty gap list.
+ *
+ * @param G Pointer to the list to be initialized.
+ * @param capacity Number of elements to allocate up front (LIST_INIT_SIZE if less than 1).
+ * @return LIST_OK on success, LIST_ERR_NOMEM if the allocation failed.
+ */
+int InitGapList(GapList* G, int capacity);
+
+/**
+ * @brief Destroys the gap list and releases its memory.
+ *
+ * @param G Pointer to the list to be destroyed.
+ */
+void DestroyGapList(GapList* G);
+
+/**
+ * @brief Returns the number of elements in the gap list.
+ *
+ * @param G Pointer to the list.
+ * @return The number of elements.
+ */
+int GapListLength(GapList* G);
+
+/**
+ * @brief Retrieves the element at the specified position.
+ *
+ * @param G Pointer to the list.
+ * @param i The position (1-based index) of the element to retrieve.
+ * @param result Pointer to store the element if found.
+ * @return LIST_OK on success, LIST_ERR_POSITION if the position is invalid.
+ */
+int GapOrderNum(GapList* G, int i, ElemType* result);
+
+/**
+ * @brief Inserts an element at the specified position.
+ *
+ * Costs O(distance from the previous edit), amortized over growth.
+ *
+ * @param G Pointer to the list.
+ * @param i The position (1-based index) at which to insert the element.
+ * @param e The element to be inserted.
+ * @return LIST_OK on success, LIST_ERR_POSITION if 'i' is out of range,
+ *         LIST_ERR_FULL or LIST_ERR_NOMEM if the list could not grow.
+ */
+int GapListInsert(GapList* G, int i, ElemType e);
+
+/**
+ * @brief Deletes the element at the specified position.
+ *
+ * Costs O(distance from the previous edit). Like ShrinkList, releases
+ * memory once less than 1/LIST_SHRINK_THRESHOLD of the capacity is in use.
+ *
+ * @param G Pointer to the list.
+ * @param i The position (1-based index) of the element to delete.
+ * @return LIST_OK on success, LIST_ERR_POSITION if 'i' is out of range.
+ */
+int GapListDelete(GapList* G, int i);
+
+/**
+ * @brief Locates an element and returns its position.
+ *
+ * @param G Pointer to the list.
+ * @param e The element to locate.
+ * @return The position (1-based index) of the first element equal to 'e', or 0 if not found.
+ */
+int GapLocateElem(GapList* G, ElemType e);
+
+/**
+ * @brief Moves the gap to the end so that all elements are contiguous.
+ *
+ * @param G Pointer to the list.
+ * @return Pointer to the first of GapListLength(G) contiguous elements; valid until the next edit.
+ */
+const ElemType* GapListCompact(GapList* G);
+
+#endif
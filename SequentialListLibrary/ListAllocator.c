@@ -0,0 +1,284 @@
+#include "ListAllocator.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Rounds 'size' up to a multiple of LIST_ALLOC_ALIGN.
+ */
+static size_t AlignUp(size_t size) {
+    return (size + (LIST_ALLOC_ALIGN - 1)) & ~(size_t)(LIST_ALLOC_ALIGN - 1);
+}
+
+/*
+ * Bump arena.
+ */
+
+struct ListArenaChunk {
+    struct ListArenaChunk* next; ///< Next chunk in allocation order
+    size_t size; ///< Usable bytes in 'data'
+    size_t used; ///< Bytes handed out from 'data'
+    size_t last; ///< Offset of the most recent block, for in-place growth and release
+};
+
+/**
+ * @brief Appends a chunk of at least 'size' usable bytes after the current one.
+ */
+static struct ListArenaChunk* ArenaNewChunk(ListArena* A, size_t size) {
+    struct ListArenaChunk* chunk = (struct ListArenaChunk*)malloc(AlignUp(sizeof(struct ListArenaChunk)) + size);
+    if (!chunk) {
+        return NULL;
+    }
+    chunk->size = size;
+    chunk->used = 0;
+    chunk->last = 0;
+    if (A->current == NULL) {
+        chunk->next = A->head;
+        A->head = chunk;
+    }
+    else {
+        chunk->next = A->current->next;
+        A->current->next = chunk;
+    }
+    A->current = chunk;
+    return chunk;
+}
+
+/**
+ * @brief Returns the start of a chunk's data area, which follows the header.
+ */
+static char* ArenaData(struct ListArenaChunk* chunk) {
+    return (char*)chunk + AlignUp(sizeof(struct ListArenaChunk));
+}
+
+static void* ArenaAllocate(void* ctx, size_t size) {
+    ListArena* A = (ListArena*)ctx;
+    size = AlignUp(size > 0 ? size : 1);
+    struct ListArenaChunk* chunk = A->current;
+    // Skip to the next reusable chunk that fits, or add a new one.
+    while (chunk != NULL && chunk->size - chunk->used < size) {
+        chunk = chunk->next;
+        if (chunk != NULL) {
+            A->current = chunk;
+        }
+    }
+    if (chunk == NULL) {
+        chunk = ArenaNewChunk(A, size > A->chunkSize ? size : A->chunkSize);
+        if (chunk == NULL) {
+            return NULL;
+        }
+    }
+    chunk->last = chunk->used;
+    chunk->used += size;
+    return ArenaData(chunk) + chunk->last;
+}
+
+static void* ArenaReallocate(void* ctx, void* ptr, size_t oldSize, size_t newSize) {
+    ListArena* A = (ListArena*)ctx;
+    struct ListArenaChunk* chunk = A->current;
+    if (ptr == NULL) {
+        return ArenaAllocate(ctx, newSize);
+    }
+    // The most recent block can grow or shrink in place.
+    if (chunk != NULL && (char*)ptr == ArenaData(chunk) + chunk->last) {
+        size_t size = AlignUp(newSize > 0 ? newSize : 1);
+        if (size <= chunk->size - chunk->last) {
+            chunk->used = chunk->last + size;
+            return ptr;
+        }
+    }
+    if (newSize <= oldSize) {
+        return ptr;
+    }
+    void* block = ArenaAllocate(ctx, newSize);
+    if (block != NULL) {
+        memcpy(block, ptr, oldSize);
+    }
+    return block;
+}
+
+static void ArenaRelease(void* ctx, void* ptr, size_t size) {
+    ListArena* A = (ListArena*)ctx;
+    struct ListArenaChunk* chunk = A->current;
+    (void)size;
+    if (chunk != NULL && (char*)ptr == ArenaData(chunk) + chunk->last) {
+        chunk->used = chunk->last;
+    }
+}
+
+/**
+ * @brief Initializes an empty arena.
+ *
+ * No memory is allocated until the first request.
+ *
+ * @param A Pointer to the arena.
+ * @param chunkSize Bytes per chunk; LIST_ARENA_CHUNK_SIZE if 0.
+ */
+void InitListArena(ListArena* A, size_t chunkSize) {
+    A->head = NULL;
+    A->current = NULL;
+    A->chunkSize = AlignUp(chunkSize > 0 ? chunkSize : LIST_ARENA_CHUNK_SIZE);
+    A->allocator.allocate = ArenaAllocate;
+    A->allocator.reallocate = ArenaReallocate;
+    A->allocator.release = ArenaRelease;
+    A->allocator.ctx = A;
+}
+
+/**
+ * @brief Makes all memory of the arena available again.
+ *
+ * Regular chunks are kept and refilled from the start; oversized chunks,
+ * which only served single large requests, are freed.
+ *
+ * @param A Pointer to the arena.
+ */
+void ResetListArena(ListArena* A) {
+    struct ListArenaChunk** link = &A->head;
+    while (*link != NULL) {
+        struct ListArenaChunk* chunk = *link;
+        if (chunk->size > A->chunkSize) {
+            *link = chunk->next;
+            free(chunk);
+        }
+        else {
+            chunk->used = 0;
+            chunk->last = 0;
+            link = &chunk->next;
+        }
+    }
+    A->current = A->head;
+}
+
+/**
+ * @brief Frees all chunks of the arena.
+ *
+ * @param A Pointer to the arena.
+ */
+void DestroyListArena(ListArena* A) {
+    while (A->head != NULL) {
+        struct ListArenaChunk* next = A->head->next;
+        free(A->head);
+        A->head = next;
+    }
+    A->current = NULL;
+}
+
+/*
+ * Size-class pool.
+ */
+
+struct ListPoolSlab {
+    struct ListPoolSlab* next; ///< Previously allocated slab
+};
+
+/**
+ * @brief Returns the size class of a request, or -1 if it is too large for the pool.
+ */
+static int PoolClass(size_t size) {
+    int c = 0;
+    size_t classSize = (size_t)1 << LIST_POOL_MIN_SHIFT;
+    while (classSize < size) {
+        classSize <<= 1;
+        if (++c >= LIST_POOL_CLASSES) {
+            return -1;
+        }
+    }
+    return c;
+}
+
+static void* PoolAllocate(void* ctx, size_t size) {
+    ListPool* P = (ListPool*)ctx;
+    int c = PoolClass(size);
+    if (c < 0) {
+        return malloc(size);
+    }
+    void* block = P->freeLists[c];
+    if (block != NULL) {
+        P->freeLists[c] = *(void**)block;
+        return block;
+    }
+    size_t classSize = (size_t)1 << (c + LIST_POOL_MIN_SHIFT);
+    if ((size_t)(P->limit - P->cursor) < classSize) {
+        // The unused tail of the old slab is simply abandoned.
+        size_t header = AlignUp(sizeof(struct ListPoolSlab));
+        struct ListPoolSlab* slab = (struct ListPoolSlab*)malloc(header + LIST_POOL_SLAB_SIZE);
+        if (!slab) {
+            return NULL;
+        }
+        slab->next = P->slabs;
+        P->slabs = slab;
+        P->cursor = (char*)slab + header;
+        P->limit = P->cursor + LIST_POOL_SLAB_SIZE;
+    }
+    block = P->cursor;
+    P->cursor += classSize;
+    return block;
+}
+
+static void PoolRelease(void* ctx, void* ptr, size_t size) {
+    ListPool* P = (ListPool*)ctx;
+    if (ptr == NULL) {
+        return;
+    }
+    int c = PoolClass(size);
+    if (c < 0) {
+        free(ptr);
+        return;
+    }
+    *(void**)ptr = P->freeLists[c];
+    P->freeLists[c] = ptr;
+}
+
+static void* PoolReallocate(void* ctx, void* ptr, size_t oldSize, size_t newSize) {
+    if (ptr == NULL) {
+        return PoolAllocate(ctx, newSize);
+    }
+    int oldClass = PoolClass(oldSize);
+    int newClass = PoolClass(newSize);
+    if (oldClass >= 0 && oldClass == newClass) {
+        return ptr;
+    }
+    if (oldClass < 0 && newClass < 0) {
+        return realloc(ptr, newSize);
+    }
+    void* block = PoolAllocate(ctx, newSize);
+    if (block != NULL) {
+        memcpy(block, ptr, oldSize < newSize ? oldSize : newSize);
+        PoolRelease(ctx, ptr, oldSize);
+    }
+    return block;
+}
+
+/**
+ * @brief Initializes an empty size-class pool.
+ *
+ * @param P Pointer to the pool.
+ */
+void InitListPool(ListPool* P) {
+    for (int c = 0; c < LIST_POOL_CLASSES; c++) {
+        P->freeLists[c] = NULL;
+    }
+    P->slabs = NULL;
+    P->cursor = NULL;
+    P->limit = NULL;
+    P->allocator.allocate = PoolAllocate;
+    P->allocator.reallocate = PoolReallocate;
+    P->allocator.release = PoolRelease;
+    P->allocator.ctx = P;
+}
+
+/**
+ * @brief Frees all memory of the pool.
+ *
+ * Blocks larger than the biggest size class came from malloc and must have
+ * been released already; everything else is freed with the slabs.
+ *
+ * @param P Pointer to the pool.
+ */
+void DestroyListPool(ListPool* P) {
+    while (P->slabs != NULL) {
+        struct ListPoolSlab* next = P->slabs->next;
+        free(P->slabs);
+        P->slabs = next;
+    }
+    InitListPool(P);
+}
@@ -0,0 +1,114 @@
+#ifndef XPERANCE_LISTALLOCATOR
+#define XPERANCE_LISTALLOCATOR
+
+#include <stddef.h>
+
+/*
+ * Pluggable storage for the element arrays of SqList.
+ *
+ * A list created with InitListWithAllocator obtains, resizes and releases
+ * its element array through the hooks below instead of malloc, realloc and
+ * free. Every call passes the sizes involved, so allocators need not keep
+ * per-block headers. Two implementations are bundled: a bump arena whose
+ * memory is reclaimed all at once, and a pool of power-of-two size classes
+ * with per-class free lists. Neither is thread-safe; use one per thread.
+ */
+
+/**
+ * @brief A set of allocation hooks and the state they operate on.
+ *
+ * @allocate Returns 'size' bytes, or NULL on failure.
+ * @reallocate Resizes a block from 'oldSize' to 'newSize' bytes, keeping its
+ *             contents; returns NULL on failure, leaving the block intact.
+ * @release Frees a block of 'size' bytes.
+ * @ctx Passed as the first argument to every hook.
+ */
+typedef struct {
+    void* (*allocate)(void* ctx, size_t size); ///< Allocates 'size' bytes
+    void* (*reallocate)(void* ctx, void* ptr, size_t oldSize, size_t newSize); ///< Resizes a block
+    void (*release)(void* ctx, void* ptr, size_t size); ///< Frees a block of 'size' bytes
+    void* ctx; ///< Allocator state handed to the hooks
+} ListAllocator;
+
+#define LIST_ALLOC_ALIGN 16 ///< Alignment of every block returned by the bundled allocators
+#define LIST_ARENA_CHUNK_SIZE 65536 ///< Default chunk size of a ListArena
+#define LIST_POOL_MIN_SHIFT 4 ///< Smallest pool size class is 1 << LIST_POOL_MIN_SHIFT bytes
+#define LIST_POOL_CLASSES 13 ///< Number of pool size classes (16 bytes to 64 KiB)
+#define LIST_POOL_SLAB_SIZE 262144 ///< Bytes requested from malloc at a time to carve pool blocks from
+
+struct ListArenaChunk;
+struct ListPoolSlab;
+
+/**
+ * @brief A bump allocator that releases everything at once.
+ *
+ * Allocation advances a pointer in the current chunk. Releasing or growing
+ * the most recent block works in place; other releases are ignored until
+ * ResetListArena reclaims the whole arena.
+ */
+typedef struct {
+    struct ListArenaChunk* head; ///< First chunk; chunks are reused in order after a reset
+    struct ListArenaChunk* current; ///< Chunk allocations are currently taken from
+    size_t chunkSize; ///< Usable size of a regular chunk
+    ListAllocator allocator; ///< Hooks bound to this arena, for InitListWithAllocator
+} ListArena;
+
+/**
+ * @brief A size-class allocator with per-class free lists.
+ *
+ * Requests are rounded up to a power of two between 16 bytes and 64 KiB and
+ * served from a free list, so blocks released by one list are reused by the
+ * next without calling malloc. Larger requests go to malloc directly.
+ */
+typedef struct {
+    void* freeLists[LIST_POOL_CLASSES]; ///< Singly linked free blocks of each size class
+    struct ListPoolSlab* slabs; ///< Memory obtained from malloc, freed by DestroyListPool
+    char* cursor; ///< Next unused byte of the newest slab
+    char* limit; ///< End of the newest slab
+    ListAllocator allocator; ///< Hooks bound to this pool, for InitListWithAllocator
+} ListPool;
+
+/**
+ * @brief Initializes an empty arena.
+ *
+ * @param A Pointer to the arena.
+ * @param chunkSize Bytes per chunk; LIST_ARENA_CHUNK_SIZE if 0. Larger
+ *                  requests get a chunk of their own.
+ */
+void InitListArena(ListArena* A, size_t chunkSize);
+
+/**
+ * @brief Makes all memory of the arena available again.
+ *
+ * Every block handed out since the last reset becomes invalid; lists using
+ * the arena must not be used (or destroyed) afterwards. Regular chunks are
+ * kept for reuse; oversized ones are returned to malloc.
+ *
+ * @param A Pointer to the arena.
+ */
+void ResetListArena(ListArena* A);
+
+/**
+ * @brief Frees all chunks of the arena.
+ *
+ * @param A Pointer to the arena.
+ */
+void DestroyListArena(ListArena* A);
+
+/**
+ * @brief Initializes an empty size-class pool.
+ *
+ * @param P Pointer to the pool.
+ */
+void InitListPool(ListPool* P);
+
+/**
+ * @brief Frees all memory of the pool.
+ *
+ * Every block handed out by the pool becomes invalid.
+ *
+ * @param P Pointer to the pool.
+ */
+void DestroyListPool(ListPool* P);
+
+#endif
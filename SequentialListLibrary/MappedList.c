@@ -0,0 +1,276 @@
+#define _GNU_SOURCE
+
+#include "MappedList.h"
+#include <fcntl.h>
+#include <limits.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define HEADER_SIZE sizeof(MappedListHeader)
+
+/**
+ * @brief Returns the header at the start of the mapping.
+ */
+static MappedListHeader* Header(const MappedList* M) {
+    return (MappedListHeader*)M->base;
+}
+
+/**
+ * @brief Computes a Fletcher-style checksum of 'n' elements.
+ *
+ * The second sum weights every element by its distance from the end, so
+ * reordered elements change the result as well as altered ones.
+ */
+static uint64_t Checksum(const ElemType* elem, uint64_t n) {
+    const unsigned char* bytes = (const unsigned char*)elem;
+    size_t words = (size_t)n * sizeof(ElemType) / sizeof(uint32_t);
+    uint64_t a = 0;
+    uint64_t b = 0;
+    for (size_t i = 0; i < words; i++) {
+        uint32_t w;
+        memcpy(&w, bytes + i * sizeof(uint32_t), sizeof(w));
+        a += w;
+        b += a;
+    }
+    return (b << 32) ^ a ^ n;
+}
+
+/**
+ * @brief Sets the capacity to 'size' bytes of elements, growing the file and the mapping if needed.
+ *
+ * The file and the mapping never shrink: other processes may have the file
+ * mapped at its current size and would fault on pages past a new end of
+ * file. A smaller capacity only lowers the header's capacity, and a later
+ * growth up to the mapped size reuses the space. A read-only list cannot
+ * grow. On failure the old mapping stays valid (the file may already have grown).
+ */
+static int Remap(MappedList* M, size_t size) {
+    size_t newMapSize = HEADER_SIZE + size;
+    if (newMapSize <= M->mapSize) {
+        Header(M)->capacity = size / sizeof(ElemType);
+        return 1;
+    }
+    if (M->readOnly || ftruncate(M->fd, (off_t)newMapSize) != 0) {
+        return 0;
+    }
+#ifdef MREMAP_MAYMOVE
+    void* base = mremap(M->base, M->mapSize, newMapSize, MREMAP_MAYMOVE);
+    if (base == MAP_FAILED) {
+        return 0;
+    }
+#else
+    void* base = mmap(NULL, newMapSize, PROT_READ | PROT_WRITE, MAP_SHARED, M->fd, 0);
+    if (base == MAP_FAILED) {
+        return 0;
+    }
+    munmap(M->base, M->mapSize);
+#endif
+    M->base = (unsigned char*)base;
+    M->mapSize = newMapSize;
+    Header(M)->capacity = size / sizeof(ElemType);
+    return 1;
+}
+
+/**
+ * @brief Allocator hook: maps room for the first element array of a new file.
+ */
+static void* MappedAllocate(void* ctx, size_t size) {
+    MappedList* M = (MappedList*)ctx;
+    if (ftruncate(M->fd, (off_t)(HEADER_SIZE + size)) != 0) {
+        return NULL;
+    }
+    void* base = mmap(NULL, HEADER_SIZE + size, PROT_READ | PROT_WRITE, MAP_SHARED, M->fd, 0);
+    if (base == MAP_FAILED) {
+        return NULL;
+    }
+    M->base = (unsigned char*)base;
+    M->mapSize = HEADER_SIZE + size;
+    return M->base + HEADER_SIZE;
+}
+
+/**
+ * @brief Allocator hook: changes the capacity in place of realloc (see Remap).
+ */
+static void* MappedReallocate(void* ctx, void* ptr, size_t oldSize, size_t newSize) {
+    MappedList* M = (MappedList*)ctx;
+    (void)ptr;
+    (void)oldSize;
+    if (!Remap(M, newSize)) {
+        return NULL;
+    }
+    return M->base + HEADER_SIZE;
+}
+
+/**
+ * @brief Allocator hook: unmaps the file when the list is destroyed.
+ */
+static void MappedRelease(void* ctx, void* ptr, size_t size) {
+    MappedList* M = (MappedList*)ctx;
+    (void)ptr;
+    (void)size;
+    munmap(M->base, M->mapSize);
+    M->base = NULL;
+    M->mapSize = 0;
+}
+
+/**
+ * @brief Sets up the fields shared by CreateMappedList and OpenMappedList.
+ */
+static void BindAllocator(MappedList* M, int fd, int readOnly) {
+    M->allocator.allocate = MappedAllocate;
+    M->allocator.reallocate = MappedReallocate;
+    M->allocator.release = MappedRelease;
+    M->allocator.ctx = M;
+    M->fd = fd;
+    M->readOnly = readOnly;
+    M->base = NULL;
+    M->mapSize = 0;
+}
+
+/**
+ * @brief Creates (or truncates) a list file and opens it for writing.
+ *
+ * @param M Pointer to the mapped list.
+ * @param path Path of the file.
+ * @param capacity Initial capacity in elements (LIST_INIT_SIZE if less than 1).
+ * @return LIST_OK on success, LIST_ERR_IO if the file could not be created or mapped.
+ */
+int CreateMappedList(MappedList* M, const char* path, int capacity) {
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return LIST_ERR_IO;
+    }
+    BindAllocator(M, fd, 0);
+    if (InitListWithAllocator(&M->list, capacity, &M->allocator) != LIST_OK) {
+        close(fd);
+        return LIST_ERR_IO;
+    }
+    MappedListHeader* h = Header(M);
+    memset(h, 0, HEADER_SIZE);
+    h->magic = MAPPED_LIST_MAGIC;
+    h->version = MAPPED_LIST_VERSION;
+    h->elemSize = sizeof(ElemType);
+    h->capacity = (uint64_t)M->list.listsize;
+    h->checksum = Checksum(M->list.elem, 0);
+    return LIST_OK;
+}
+
+/**
+ * @brief Opens an existing list file.
+ *
+ * Only the header is read, unless MAPPED_LIST_VERIFY is given. A file
+ * opened for writing is marked as not cleanly closed until the next sync.
+ *
+ * @param M Pointer to the mapped list.
+ * @param path Path of the file.
+ * @param flags MAPPED_LIST_READONLY and/or MAPPED_LIST_VERIFY, or 0.
+ * @return LIST_OK on success, LIST_ERR_IO, LIST_ERR_FORMAT or LIST_ERR_CHECKSUM otherwise.
+ */
+int OpenMappedList(MappedList* M, const char* path, int flags) {
+    int readOnly = (flags & MAPPED_LIST_READONLY) != 0;
+    int fd = open(path, readOnly ? O_RDONLY : O_RDWR);
+    if (fd < 0) {
+        return LIST_ERR_IO;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return LIST_ERR_IO;
+    }
+    if ((uint64_t)st.st_size < HEADER_SIZE) {
+        close(fd);
+        return LIST_ERR_FORMAT;
+    }
+    // A read-only list is mapped privately, so writes through SqList functions
+    // stay in this process instead of faulting or reaching the file.
+    void* base = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, readOnly ? MAP_PRIVATE : MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) {
+        close(fd);
+        return LIST_ERR_IO;
+    }
+    BindAllocator(M, fd, readOnly);
+    M->base = (unsigned char*)base;
+    M->mapSize = (size_t)st.st_size;
+    const MappedListHeader* h = Header(M);
+    int status = LIST_OK;
+    if (h->magic != MAPPED_LIST_MAGIC || h->version != MAPPED_LIST_VERSION || h->elemSize != sizeof(ElemType)
+            || h->capacity < 1 || h->capacity > INT_MAX || h->length > h->capacity
+            || h->capacity > ((uint64_t)st.st_size - HEADER_SIZE) / sizeof(ElemType)) {
+        status = LIST_ERR_FORMAT;
+    }
+    else if ((flags & MAPPED_LIST_VERIFY)
+            && ((!readOnly && !h->clean) || Checksum((const ElemType*)(M->base + HEADER_SIZE), h->length) != h->checksum)) {
+        // A reader may share the file with a live writer, which keeps 'clean' at 0;
+        // it checks the elements as of the writer's last sync instead.
+        status = LIST_ERR_CHECKSUM;
+    }
+    if (status != LIST_OK) {
+        munmap(M->base, M->mapSize);
+        close(fd);
+        M->base = NULL;
+        M->mapSize = 0;
+        return status;
+    }
+    M->list.elem = (ElemType*)(M->base + HEADER_SIZE);
+    M->list.length = (int)h->length;
+    M->list.listsize = (int)h->capacity;
+    M->list.index = NULL;
+    M->list.allocator = &M->allocator;
+    if (!readOnly) {
+        Header(M)->clean = 0;
+    }
+    return LIST_OK;
+}
+
+/**
+ * @brief Fills in the header, marks the file clean and flushes it to disk.
+ *
+ * @return LIST_OK on success, LIST_ERR_IO if the flush failed.
+ */
+static int WriteHeader(MappedList* M) {
+    MappedListHeader* h = Header(M);
+    h->length = (uint64_t)M->list.length;
+    h->capacity = (uint64_t)M->list.listsize;
+    h->checksum = Checksum(M->list.elem, h->length);
+    h->clean = 1;
+    return msync(M->base, M->mapSize, MS_SYNC) == 0 ? LIST_OK : LIST_ERR_IO;
+}
+
+/**
+ * @brief Writes the length and checksum to the header and flushes the file to disk.
+ *
+ * The file is marked clean only for the flush; afterwards it counts as
+ * modified again, since the list may change without the file knowing.
+ *
+ * @param M Pointer to the mapped list.
+ * @return LIST_OK on success, LIST_UNCHANGED for a read-only list, LIST_ERR_IO if the flush failed.
+ */
+int SyncMappedList(MappedList* M) {
+    if (M->readOnly) {
+        return LIST_UNCHANGED;
+    }
+    int status = WriteHeader(M);
+    Header(M)->clean = 0;
+    return status;
+}
+
+/**
+ * @brief Syncs (unless read-only), unmaps and closes the file.
+ *
+ * @param M Pointer to the mapped list.
+ * @return LIST_OK on success, LIST_ERR_IO if the final sync failed.
+ */
+int CloseMappedList(MappedList* M) {
+    int status = LIST_OK;
+    if (!M->readOnly) {
+        status = WriteHeader(M);
+    }
+    DestroyList(&M->list);
+    if (close(M->fd) != 0) {
+        status = LIST_ERR_IO;
+    }
+    M->fd = -1;
+    return status;
+}
@@ -0,0 +1,109 @@
+#ifndef XPERANCE_MAPPEDLIST
+#define XPERANCE_MAPPEDLIST
+
+#include "SqList.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * SqList whose elements live in a memory-mapped file.
+ *
+ * The file holds a MappedListHeader followed by the element array. The
+ * list inside a MappedList is an ordinary SqList whose allocator maps the
+ * file: when the list grows, the file is extended with ftruncate and
+ * remapped instead of realloc'd, so every SqList function works on it
+ * unchanged. The file never shrinks, since other processes may map it; a
+ * shrinking list only lowers the capacity in the header and reuses the
+ * space when it grows again. Opening an existing file maps it without
+ * reading the elements, so reopening takes the same time at any size.
+ *
+ * The header's length and checksum are written by SyncMappedList and
+ * CloseMappedList. A file left open for writing by a process that died is
+ * marked as not cleanly closed; its header length is the one of the last
+ * sync. A file opened with MAPPED_LIST_READONLY can be shared by any
+ * number of processes, alongside one writer. Its list is mapped privately:
+ * changes to it stay in the process and are never written to the file,
+ * and growing it past the file's size fails with LIST_ERR_NOMEM.
+ *
+ * MAPPED_LIST_VERIFY checks the first 'length' elements against the
+ * checksum of the last sync. Opened for writing, it also requires the file
+ * to have been closed cleanly. Opened read-only, it does not, so a reader
+ * can verify a file that a writer still has open; it then succeeds only if
+ * the writer has not changed those elements since its last sync, and may
+ * fail spuriously while that sync is in progress.
+ */
+
+#define MAPPED_LIST_MAGIC 0x315453494C515358ULL ///< "XSQLIST1" read as a little-endian 64-bit word
+#define MAPPED_LIST_VERSION 1 ///< Current file format version
+#define MAPPED_LIST_READONLY 1 ///< OpenMappedList flag: open the file read-only (changes to the list stay private)
+#define MAPPED_LIST_VERIFY 2 ///< OpenMappedList flag: check the checksum (reads every element)
+
+/**
+ * @brief On-disk header at the start of a list file (64 bytes, native byte order).
+ */
+typedef struct {
+    uint64_t magic; ///< MAPPED_LIST_MAGIC
+    uint32_t version; ///< MAPPED_LIST_VERSION
+    uint32_t elemSize; ///< sizeof(ElemType) of the writer
+    uint64_t length; ///< Number of elements at the last sync
+    uint64_t capacity; ///< Number of elements the file has room for
+    uint64_t checksum; ///< Checksum of the first 'length' elements at the last sync
+    uint32_t clean; ///< Nonzero if the file was synced and not modified since
+    uint32_t reserved[5]; ///< Zero
+} MappedListHeader;
+
+/**
+ * @brief A list backed by a file.
+ *
+ * Use 'list' with any SqList function. The allocator is bound to this
+ * structure, so it must not be moved while open.
+ */
+typedef struct {
+    SqList list; ///< The list; its elements are in the mapping
+    ListAllocator allocator; ///< Hooks that resize the file and the mapping
+    int fd; ///< The open file
+    int readOnly; ///< Nonzero if opened with MAPPED_LIST_READONLY
+    unsigned char* base; ///< Start of the mapping (the header)
+    size_t mapSize; ///< Bytes mapped
+} MappedList;
+
+/**
+ * @brief Creates (or truncates) a list file and opens it for writing.
+ *
+ * @param M Pointer to the mapped list.
+ * @param path Path of the file.
+ * @param capacity Initial capacity in elements (LIST_INIT_SIZE if less than 1).
+ * @return LIST_OK on success, LIST_ERR_IO if the file could not be created or mapped.
+ */
+int CreateMappedList(MappedList* M, const char* path, int capacity);
+
+/**
+ * @brief Opens an existing list file.
+ *
+ * @param M Pointer to the mapped list.
+ * @param path Path of the file.
+ * @param flags MAPPED_LIST_READONLY and/or MAPPED_LIST_VERIFY, or 0.
+ * @return LIST_OK on success, LIST_ERR_IO if the file could not be opened or mapped,
+ *         LIST_ERR_FORMAT if it is not a list file of this version and element type,
+ *         LIST_ERR_CHECKSUM if MAPPED_LIST_VERIFY was given and the elements do not
+ *         match the checksum, or the file is opened for writing and was not closed cleanly.
+ */
+int OpenMappedList(MappedList* M, const char* path, int flags);
+
+/**
+ * @brief Writes the length and checksum to the header and flushes the file to disk.
+ *
+ * @param M Pointer to the mapped list.
+ * @return LIST_OK on success, LIST_UNCHANGED for a read-only list, LIST_ERR_IO if the flush failed.
+ */
+int SyncMappedList(MappedList* M);
+
+/**
+ * @brief Syncs (unless read-only), unmaps and closes the file.
+ *
+ * @param M Pointer to the mapped list.
+ * @return LIST_OK on success, LIST_ERR_IO if the final sync failed.
+ */
+int CloseMappedList(MappedList* M);
+
+#endif
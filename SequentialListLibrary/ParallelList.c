@@ -0,0 +1,541 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "ParallelList.h"
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define LOCATE_BLOCK 4096 ///< Elements ParallelLocateElem scans between checks for an earlier match
+
+/**
+ * @brief Claims and runs chunks of the current job until none are left.
+ */
+static void RunChunks(ListThreadPool* P) {
+    for (;;) {
+        int chunk = atomic_fetch_add(&P->nextChunk, 1);
+        if (chunk >= P->chunks) {
+            return;
+        }
+        P->job(P->ctx, chunk);
+    }
+}
+
+/**
+ * @brief Helper thread: waits for a job, works on it, reports back.
+ */
+static void* WorkerMain(void* arg) {
+    ListThreadPool* P = (ListThreadPool*)arg;
+    // InitListThreadPool sets the generation to 0 before starting any worker.
+    // Reading it here instead would skip a job submitted before this thread
+    // first takes the lock, and the caller would wait for it forever.
+    unsigned long seen = 0;
+    pthread_mutex_lock(&P->lock);
+    for (;;) {
+        while (!P->shutdown && P->generation == seen) {
+            pthread_cond_wait(&P->wake, &P->lock);
+        }
+        if (P->shutdown) {
+            break;
+        }
+        seen = P->generation;
+        pthread_mutex_unlock(&P->lock);
+        RunChunks(P);
+        pthread_mutex_lock(&P->lock);
+        if (--P->busy == 0) {
+            pthread_cond_signal(&P->done);
+        }
+    }
+    pthread_mutex_unlock(&P->lock);
+    return NULL;
+}
+
+/**
+ * @brief Starts a thread pool.
+ *
+ * @param P Pointer to the pool.
+ * @param threads Number of threads including the caller, or 0 for one per online CPU.
+ * @param threshold List length below which operations stay serial, or 0 for PARALLEL_LIST_THRESHOLD.
+ * @return LIST_OK on success, LIST_ERR_NOMEM if the pool could not be allocated.
+ */
+int InitListThreadPool(ListThreadPool* P, int threads, int threshold) {
+    if (threads <= 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = cpus > 0 ? (int)cpus : 1;
+    }
+    P->threshold = threshold > 0 ? threshold : PARALLEL_LIST_THRESHOLD;
+    P->helpers = 0;
+    P->workers = NULL;
+    if (threads > 1) {
+        P->workers = (pthread_t*)malloc((size_t)(threads - 1) * sizeof(pthread_t));
+        if (P->workers == NULL) {
+            return LIST_ERR_NOMEM;
+        }
+    }
+    pthread_mutex_init(&P->runLock, NULL);
+    pthread_mutex_init(&P->lock, NULL);
+    pthread_cond_init(&P->wake, NULL);
+    pthread_cond_init(&P->done, NULL);
+    P->job = NULL;
+    P->ctx = NULL;
+    P->chunks = 0;
+    atomic_init(&P->nextChunk, 0);
+    P->busy = 0;
+    P->generation = 0;
+    P->shutdown = 0;
+    // A failed pthread_create just means fewer helpers.
+    for (int t = 1; t < threads; t++) {
+        if (pthread_create(&P->workers[P->helpers], NULL, WorkerMain, P) == 0) {
+            P->helpers++;
+        }
+    }
+    P->threads = P->helpers + 1;
+    return LIST_OK;
+}
+
+/**
+ * @brief Stops and joins the pool's threads. No operation may be running.
+ *
+ * @param P Pointer to the pool.
+ */
+void DestroyListThreadPool(ListThreadPool* P) {
+    pthread_mutex_lock(&P->lock);
+    P->shutdown = 1;
+    pthread_cond_broadcast(&P->wake);
+    pthread_mutex_unlock(&P->lock);
+    for (int t = 0; t < P->helpers; t++) {
+        pthread_join(P->workers[t], NULL);
+    }
+    free(P->workers);
+    P->workers = NULL;
+    P->helpers = 0;
+    P->threads = 1;
+    pthread_cond_destroy(&P->done);
+    pthread_cond_destroy(&P->wake);
+    pthread_mutex_destroy(&P->lock);
+    pthread_mutex_destroy(&P->runLock);
+}
+
+static ListThreadPool sharedPool;
+static ListThreadPool* sharedPoolPtr = NULL;
+static pthread_once_t sharedPoolOnce = PTHREAD_ONCE_INIT;
+
+static void InitSharedPool(void) {
+    if (InitListThreadPool(&sharedPool, 0, 0) == LIST_OK) {
+        sharedPoolPtr = &sharedPool;
+    }
+}
+
+/**
+ * @brief Returns the process-wide pool, creating it on first use.
+ *
+ * @return The shared pool, or NULL if it could not be created.
+ */
+ListThreadPool* ListSharedThreadPool(void) {
+    pthread_once(&sharedPoolOnce, InitSharedPool);
+    return sharedPoolPtr;
+}
+
+/**
+ * @brief Returns the pool to use for a call: 'P', or the shared pool if 'P' is NULL.
+ */
+static ListThreadPool* ResolvePool(ListThreadPool* P) {
+    return P != NULL ? P : ListSharedThreadPool();
+}
+
+/**
+ * @brief Returns how many chunks a list of 'n' elements is cut into on pool 'P'.
+ *
+ * One chunk means the operation runs serially. Otherwise there are four
+ * chunks per thread, so that threads finishing early can take more work.
+ */
+static int ChunkCount(const ListThreadPool* P, int n) {
+    if (P == NULL || P->threads < 2 || n < P->threshold) {
+        return 1;
+    }
+    int chunks = P->threads * 4;
+    if (chunks > PARALLEL_LIST_MAX_CHUNKS) {
+        chunks = PARALLEL_LIST_MAX_CHUNKS;
+    }
+    return chunks < n ? chunks : n;
+}
+
+/**
+ * @brief Returns the first index of chunk 'c' out of 'chunks' over 'n' elements.
+ */
+static int ChunkStart(int n, int chunks, int c) {
+    return (int)((long long)n * c / chunks);
+}
+
+/**
+ * @brief Runs job(ctx, c) for every chunk c in [0, chunks) and waits for all of them.
+ */
+static void RunJob(ListThreadPool* P, void (*job)(void* ctx, int chunk), void* ctx, int chunks) {
+    if (chunks == 1) {
+        job(ctx, 0);
+        return;
+    }
+    pthread_mutex_lock(&P->runLock);
+    pthread_mutex_lock(&P->lock);
+    P->job = job;
+    P->ctx = ctx;
+    P->chunks = chunks;
+    atomic_store(&P->nextChunk, 0);
+    P->busy = P->helpers;
+    P->generation++;
+    pthread_cond_broadcast(&P->wake);
+    pthread_mutex_unlock(&P->lock);
+
+    RunChunks(P);
+
+    pthread_mutex_lock(&P->lock);
+    while (P->busy > 0) {
+        pthread_cond_wait(&P->done, &P->lock);
+    }
+    pthread_mutex_unlock(&P->lock);
+    pthread_mutex_unlock(&P->runLock);
+}
+
+/**
+ * @brief Shared state of the element-wise operations.
+ */
+typedef struct {
+    ElemType* elem;
+    int n;
+    int chunks;
+    ElemType e; ///< Searched value
+    ElemType (*fn)(ElemType e); ///< Map function
+    int (*pred)(ElemType e); ///< Partition predicate
+    ElemType* scratch; ///< Partition output
+    atomic_int found; ///< Smallest index where 'e' was found, INT_MAX if none
+    int counts[PARALLEL_LIST_MAX_CHUNKS + 1]; ///< Per-chunk count, then the chunk's first output index for matches
+    long long sums[PARALLEL_LIST_MAX_CHUNKS];
+    ElemType mins[PARALLEL_LIST_MAX_CHUNKS];
+    ElemType maxs[PARALLEL_LIST_MAX_CHUNKS];
+} ParallelJob;
+
+/**
+ * @brief Fills in the fields every operation uses.
+ */
+static void InitJob(ParallelJob* job, const ListThreadPool* P, SqList* L) {
+    job->elem = L->elem;
+    job->n = L->length;
+    job->chunks = ChunkCount(P, L->length);
+}
+
+/**
+ * @brief Wraps elem[lo, hi) in a SqList so the vectorized library scans can run on it.
+ */
+static SqList ChunkView(const ParallelJob* job, int lo, int hi) {
+    SqList view;
+    view.elem = job->elem + lo;
+    view.length = hi - lo;
+    view.listsize = hi - lo;
+    view.index = NULL;
+    view.allocator = NULL;
+    return view;
+}
+
+/**
+ * @brief Finds the first 'e' in a chunk, in blocks counted with ListCountElem.
+ *
+ * Gives up as soon as another chunk has reported an earlier match.
+ */
+static void LocateChunk(void* ctx, int c) {
+    ParallelJob* job = (ParallelJob*)ctx;
+    int lo = ChunkStart(job->n, job->chunks, c);
+    int hi = ChunkStart(job->n, job->chunks, c + 1);
+    for (int b = lo; b < hi; b += LOCATE_BLOCK) {
+        if (atomic_load_explicit(&job->found, memory_order_relaxed) < b) {
+            return;
+        }
+        int end = hi - b < LOCATE_BLOCK ? hi : b + LOCATE_BLOCK;
+        SqList view = ChunkView(job, b, end);
+        if (ListCountElem(&view, job->e) == 0) {
+            continue;
+        }
+        int i = b;
+        while (job->elem[i] != job->e) {
+            i++;
+        }
+        int current = atomic_load(&job->found);
+        while (i < current && !atomic_compare_exchange_weak(&job->found, &current, i)) {
+        }
+        return;
+    }
+}
+
+/**
+ * @brief Locates an element in parallel.
+ *
+ * @param P The pool, or NULL for the shared pool.
+ * @param L Pointer to the list.
+ * @param e The element to locate.
+ * @return The position (1-based index) of the first element equal to 'e', or 0 if not found.
+ */
+int ParallelLocateElem(ListThreadPool* P, SqList* L, ElemType e) {
+    P = ResolvePool(P);
+    if (L->index != NULL || ChunkCount(P, L->length) == 1) {
+        return LocateElem(L, e);
+    }
+    ParallelJob job;
+    InitJob(&job, P, L);
+    job.e = e;
+    atomic_init(&job.found, INT_MAX);
+    RunJob(P, LocateChunk, &job, job.chunks);
+    int i = atomic_load(&job.found);
+    return i == INT_MAX ? 0 : i + 1;
+}
+
+static void CountChunk(void* ctx, int c) {
+    ParallelJob* job = (ParallelJob*)ctx;
+    SqList view = ChunkView(job, ChunkStart(job->n, job->chunks, c), ChunkStart(job->n, job->chunks, c + 1));
+    job->counts[c] = ListCountElem(&view, job->e);
+}
+
+/**
+ * @brief Counts the elements equal to 'e' in parallel.
+ *
+ * @param P The pool, or NULL for the shared pool.
+ * @param L Pointer to the list.
+ * @param e The element to count.
+ * @return The number of occurrences of 'e' in the list.
+ */
+int ParallelCountElem(ListThreadPool* P, SqList* L, ElemType e) {
+    P = ResolvePool(P);
+    ParallelJob job;
+    InitJob(&job, P, L);
+    job.e = e;
+    RunJob(P, CountChunk, &job, job.chunks);
+    int count = 0;
+    for (int c = 0; c < job.chunks; c++) {
+        count += job.counts[c];
+    }
+    return count;
+}
+
+/**
+ * @brief Computes the sum, minimum and maximum of a chunk in one pass.
+ */
+static void ReduceChunk(void* ctx, int c) {
+    ParallelJob* job = (ParallelJob*)ctx;
+    int lo = ChunkStart(job->n, job->chunks, c);
+    int hi = ChunkStart(job->n, job->chunks, c + 1);
+    const ElemType* a = job->elem;
+    long long sum = 0;
+    ElemType lowest = a[lo];
+    ElemType highest = a[lo];
+    for (int i = lo; i < hi; i++) {
+        sum += a[i];
+        lowest = a[i] < lowest ? a[i] : lowest;
+        highest = a[i] > highest ? a[i] : highest;
+    }
+    job->sums[c] = sum;
+    job->mins[c] = lowest;
+    job->maxs[c] = highest;
+}
+
+/**
+ * @brief Runs ReduceChunk over a non-empty list.
+ */
+static void Reduce(ListThreadPool* P, SqList* L, ParallelJob* job) {
+    P = ResolvePool(P);
+    InitJob(job, P, L);
+    RunJob(P, ReduceChunk, job, job->chunks);
+}
+
+/**
+ * @brief Sums the elements in parallel.
+ *
+ * @param P The pool, or NULL for the shared pool.
+ * @param L Pointer to the list.
+ * @return The sum of all elements (0 for an empty list).
+ */
+long long ParallelListSum(ListThreadPool* P, SqList* L) {
+    if (L->length == 0) {
+        return 0;
+    }
+    ParallelJob job;
+    Reduce(P, L, &job);
+    long long sum = 0;
+    for (int c = 0; c < job.chunks; c++) {
+        sum += job.sums[c];
+    }
+    return sum;
+}
+
+/**
+ * @brief Finds the smallest element in parallel.
+ *
+ * @param P The pool, or NULL for the shared pool.
+ * @param L Pointer to the list.
+ * @param result Pointer to store the smallest element.
+ * @return LIST_OK on success, LIST_ERR_NOT_FOUND if the list is empty.
+ */
+int ParallelListMin(ListThreadPool* P, SqList* L, ElemType* result) {
+    if (L->length == 0) {
+        return LIST_ERR_NOT_FOUND;
+    }
+    ParallelJob job;
+    Reduce(P, L, &job);
+    ElemType lowest = job.mins[0];
+    for (int c = 1; c < job.chunks; c++) {
+        lowest = job.mins[c] < lowest ? job.mins[c] : lowest;
+    }
+    *result = lowest;
+    return LIST_OK;
+}
+
+/**
+ * @brief Finds the largest element in parallel.
+ *
+ * @param P The pool, or NULL for the shared pool.
+ * @param L Pointer to the list.
+ * @param result Pointer to store the largest element.
+ * @return LIST_OK on success, LIST_ERR_NOT_FOUND if the list is empty.
+ */
+int ParallelListMax(ListThreadPool* P, SqList* L, ElemType* result) {
+    if (L->length == 0) {
+        return LIST_ERR_NOT_FOUND;
+    }
+    ParallelJob job;
+    Reduce(P, L, &job);
+    ElemType highest = job.maxs[0];
+    for (int c = 1; c < job.chunks; c++) {
+        highest = job.maxs[c] > highest ? job.maxs[c] : highest;
+    }
+    *result = highest;
+    return LIST_OK;
+}
+
+static void MapChunk(void* ctx, int c) {
+    ParallelJob* job = (ParallelJob*)ctx;
+    int hi = ChunkStart(job->n, job->chunks, c + 1);
+    for (int i = ChunkStart(job->n, job->chunks, c); i < hi; i++) {
+        job->elem[i] = job->fn(job->elem[i]);
+    }
+}
+
+/**
+ * @brief Replaces every element 'e' with 'fn(e)', in parallel.
+ *
+ * @param P The pool, or NULL for the shared pool.
+ * @param L Pointer to the list.
+ * @param fn The function applied to each element; called concurrently.
+ */
+void ParallelListMap(ListThreadPool* P, SqList* L, ElemType (*fn)(ElemType e)) {
+    P = ResolvePool(P);
+    ParallelJob job;
+    InitJob(&job, P, L);
+    job.fn = fn;
+    RunJob(P, MapChunk, &job, job.chunks);
+    ListInvalidateIndex(L);
+}
+
+/**
+ * @brief Partition pass 1: counts the elements of a chunk that satisfy the predicate.
+ */
+static void CountMatchesChunk(void* ctx, int c) {
+    ParallelJob* job = (ParallelJob*)ctx;
+    int hi = ChunkStart(job->n, job->chunks, c + 1);
+    int count = 0;
+    for (int i = ChunkStart(job->n, job->chunks, c); i < hi; i++) {
+        count += job->pred(job->elem[i]) != 0;
+    }
+    job->counts[c] = count;
+}
+
+/**
+ * @brief Partition pass 2: scatters a chunk to its output offsets in the scratch buffer.
+ *
+ * Matches go to counts[c] onward; the others follow all matches, after the
+ * non-matching elements of the earlier chunks. The predicate selects the
+ * destination pointer rather than a branch.
+ */
+static void ScatterChunk(void* ctx, int c) {
+    ParallelJob* job = (ParallelJob*)ctx;
+    int lo = ChunkStart(job->n, job->chunks, c);
+    int hi = ChunkStart(job->n, job->chunks, c + 1);
+    int total = job->counts[job->chunks];
+    ElemType* matches = job->scratch + job->counts[c];
+    ElemType* others = job->scratch + total + (lo - job->counts[c]);
+    int w = 0;
+    int r = 0;
+    for (int i = lo; i < hi; i++) {
+        ElemType x = job->elem[i];
+        int t = job->pred(x) != 0;
+        ElemType* dst = t ? matches + w : others + r;
+        *dst = x;
+        w += t;
+        r += 1 - t;
+    }
+}
+
+/**
+ * @brief Partition pass 3: copies a chunk of the scratch buffer back into the list.
+ */
+static void CopyBackChunk(void* ctx, int c) {
+    ParallelJob* job = (ParallelJob*)ctx;
+    int lo = ChunkStart(job->n, job->chunks, c);
+    int hi = ChunkStart(job->n, job->chunks, c + 1);
+    memcpy(job->elem + lo, job->scratch + lo, (size_t)(hi - lo) * sizeof(ElemType));
+}
+
+/**
+ * @brief Reorders the list so that the elements satisfying 'pred' come first, keeping their order.
+ *
+ * @param P The pool, or NULL for the shared pool.
+ * @param L Pointer to the list.
+ * @param pred Predicate selecting the elements that go first.
+ * @return The number of elements satisfying 'pred', or LIST_ERR_NOMEM if the
+ *         temporary buffer could not be allocated (the list is unchanged).
+ */
+int ParallelStablePartition(ListThreadPool* P, SqList* L, int (*pred)(ElemType e)) {
+    P = ResolvePool(P);
+    if (ChunkCount(P, L->length) == 1) {
+        return ListStablePartition(L, pred);
+    }
+    ParallelJob* job = (ParallelJob*)malloc(sizeof(ParallelJob));
+    ElemType* scratch = (ElemType*)malloc((size_t)L->length * sizeof(ElemType));
+    if (job == NULL || scratch == NULL) {
+        free(job);
+        free(scratch);
+        return LIST_ERR_NOMEM;
+    }
+    InitJob(job, P, L);
+    job->pred = pred;
+    job->scratch = scratch;
+    RunJob(P, CountMatchesChunk, job, job->chunks);
+    // Exclusive prefix sum; counts[chunks] becomes the total number of matches.
+    int offset = 0;
+    for (int c = 0; c < job->chunks; c++) {
+        int count = job->counts[c];
+        job->counts[c] = offset;
+        offset += count;
+    }
+    job->counts[job->chunks] = offset;
+    RunJob(P, ScatterChunk, job, job->chunks);
+    RunJob(P, CopyBackChunk, job, job->chunks);
+    free(scratch);
+    free(job);
+    ListInvalidateIndex(L);
+    return offset;
+}
+
+/**
+ * @brief Returns nonzero if 'e' is odd.
+ */
+static int IsOdd(ElemType e) {
+    return e & 1;
+}
+
+/**
+ * @brief Reorders the list such that odd numbers precede even numbers, in parallel.
+ *
+ * @param P The pool, or NULL for the shared pool.
+ * @param L Pointer to the list.
+ * @return LIST_OK on success, LIST_ERR_NOMEM if the temporary buffer could not be allocated.
+ */
+int ParallelChangeNums(ListThreadPool* P, SqList* L) {
+    return ParallelStablePartition(P, L, IsOdd) < 0 ? LIST_ERR_NOMEM : LIST_OK;
+}
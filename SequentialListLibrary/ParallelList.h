@@ -0,0 +1,158 @@
+#ifndef XPERANCE_PARALLELLIST
+#define XPERANCE_PARALLELLIST
+
+#include "SqList.h"
+#include <pthread.h>
+#include <stdatomic.h>
+
+/*
+ * Bulk operations over a SqList on several threads.
+ *
+ * The operations run on a ListThreadPool whose threads stay alive between
+ * calls, so a call pays for waking the workers rather than creating them.
+ * The list is cut into up to PARALLEL_LIST_MAX_CHUNKS chunks that the
+ * workers and the calling thread claim one at a time. Lists shorter than
+ * the pool's threshold are processed serially on the calling thread.
+ *
+ * Passing NULL as the pool selects a process-wide pool with one thread per
+ * online CPU, created on first use. A pool runs one operation at a time;
+ * concurrent callers queue. The list must not be modified by other threads
+ * during an operation, and the callbacks must not use the same pool.
+ */
+
+#define PARALLEL_LIST_THRESHOLD 262144 ///< Default length below which operations stay serial
+#define PARALLEL_LIST_MAX_CHUNKS 256 ///< Upper bound on the chunks one operation is cut into
+
+/**
+ * @brief A persistent pool of worker threads.
+ */
+typedef struct {
+    pthread_t* workers; ///< Helper threads (the caller is the remaining participant)
+    int helpers; ///< Number of helper threads actually started
+    int threads; ///< Helpers plus the calling thread
+    int threshold; ///< Lists shorter than this are processed serially
+    pthread_mutex_t runLock; ///< Held by the caller for the whole operation
+    pthread_mutex_t lock; ///< Protects the fields below
+    pthread_cond_t wake; ///< Signals a new job or shutdown
+    pthread_cond_t done; ///< Signals that the last helper finished the job
+    void (*job)(void* ctx, int chunk); ///< Function run for each chunk
+    void* ctx; ///< Argument for 'job'
+    int chunks; ///< Number of chunks in the current job
+    atomic_int nextChunk; ///< Next chunk to claim
+    int busy; ///< Helpers still working on the current job
+    unsigned long generation; ///< Incremented for every job
+    int shutdown; ///< Set by DestroyListThreadPool
+} ListThreadPool;
+
+/**
+ * @brief Starts a thread pool.
+ *
+ * @param P Pointer to the pool.
+ * @param threads Number of threads including the caller, or 0 for one per online CPU.
+ * @param threshold List length below which operations stay serial, or 0 for PARALLEL_LIST_THRESHOLD.
+ * @return LIST_OK on success, LIST_ERR_NOMEM if the pool could not be allocated.
+ *         If some threads cannot be created, the pool runs with fewer.
+ */
+int InitListThreadPool(ListThreadPool* P, int threads, int threshold);
+
+/**
+ * @brief Stops and joins the pool's threads. No operation may be running.
+ *
+ * @param P Pointer to the pool.
+ */
+void DestroyListThreadPool(ListThreadPool* P);
+
+/**
+ * @brief Returns the process-wide pool, creating it on first use.
+ *
+ * @return The shared pool, or NULL if it could not be created (operations then run serially).
+ */
+ListThreadPool* ListSharedThreadPool(void);
+
+/**
+ * @brief Locates an element in parallel.
+ *
+ * @param P The pool, or NULL for the shared pool.
+ * @param L Pointer to the list.
+ * @param e The element to locate.
+ * @return The position (1-based index) of the first element equal to 'e', or 0 if not found.
+ */
+int ParallelLocateElem(ListThreadPool* P, SqList* L, ElemType e);
+
+/**
+ * @brief Counts the elements equal to 'e' in parallel.
+ *
+ * @param P The pool, or NULL for the shared pool.
+ * @param L Pointer to the list.
+ * @param e The element to count.
+ * @return The number of occurrences of 'e' in the list.
+ */
+int ParallelCountElem(ListThreadPool* P, SqList* L, ElemType e);
+
+/**
+ * @brief Sums the elements in parallel.
+ *
+ * @param P The pool, or NULL for the shared pool.
+ * @param L Pointer to the list.
+ * @return The sum of all elements (0 for an empty list).
+ */
+long long ParallelListSum(ListThreadPool* P, SqList* L);
+
+/**
+ * @brief Finds the smallest element in parallel.
+ *
+ * @param P The pool, or NULL for the shared pool.
+ * @param L Pointer to the list.
+ * @param result Pointer to store the smallest element.
+ * @return LIST_OK on success, LIST_ERR_NOT_FOUND if the list is empty.
+ */
+int ParallelListMin(ListThreadPool* P, SqList* L, ElemType* result);
+
+/**
+ * @brief Finds the largest element in parallel.
+ *
+ * @param P The pool, or NULL for the shared pool.
+ * @param L Pointer to the list.
+ * @param result Pointer to store the largest element.
+ * @return LIST_OK on success, LIST_ERR_NOT_FOUND if the list is empty.
+ */
+int ParallelListMax(ListThreadPool* P, SqList* L, ElemType* result);
+
+/**
+ * @brief Replaces every element 'e' with 'fn(e)', in parallel.
+ *
+ * @param P The pool, or NULL for the shared pool.
+ * @param L Pointer to the list.
+ * @param fn The function applied to each element; called concurrently.
+ */
+void ParallelListMap(ListThreadPool* P, SqList* L, ElemType (*fn)(ElemType e));
+
+/**
+ * @brief Reorders the list so that the elements satisfying 'pred' come first, keeping their order.
+ *
+ * Gives the same result as ListStablePartition. Each chunk counts its
+ * matches, a prefix sum over the counts gives every chunk its output
+ * offsets, and the chunks then scatter into a temporary buffer that is
+ * copied back. 'pred' is called twice per element, concurrently.
+ *
+ * @param P The pool, or NULL for the shared pool.
+ * @param L Pointer to the list.
+ * @param pred Predicate selecting the elements that go first.
+ * @return The number of elements satisfying 'pred', or LIST_ERR_NOMEM if the
+ *         temporary buffer could not be allocated (the list is unchanged).
+ */
+int ParallelStablePartition(ListThreadPool* P, SqList* L, int (*pred)(ElemType e));
+
+/**
+ * @brief Reorders the list such that odd numbers precede even numbers, in parallel.
+ *
+ * Unlike ChangeNums the partition is stable, so the result does not depend
+ * on the number of threads.
+ *
+ * @param P The pool, or NULL for the shared pool.
+ * @param L Pointer to the list.
+ * @return LIST_OK on success, LIST_ERR_NOMEM if the temporary buffer could not be allocated.
+ */
+int ParallelChangeNums(ListThreadPool* P, SqList* L);
+
+#endif
@@ -0,0 +1,190 @@
+#include "SmallList.h"
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Initializes an empty list without allocating.
+ *
+ * @param S Pointer to the list to be initialized.
+ * @param allocator Hooks used if the list spills to the heap, or NULL for malloc/realloc/free.
+ */
+void InitSmallList(SmallList* S, const ListAllocator* allocator) {
+    S->heap = NULL;
+    S->length = 0;
+    S->listsize = SMALL_LIST_INLINE;
+    S->allocator = allocator;
+}
+
+/**
+ * @brief Frees a heap array of 'count' elements through the list's allocator.
+ */
+static void SmallRelease(SmallList* S, ElemType* heap, int count) {
+    if (S->allocator != NULL) {
+        S->allocator->release(S->allocator->ctx, heap, (size_t)count * sizeof(ElemType));
+    }
+    else {
+        free(heap);
+    }
+}
+
+/**
+ * @brief Releases the heap storage of the list, if any, and empties it.
+ *
+ * @param S Pointer to the list to be destroyed.
+ */
+void DestroySmallList(SmallList* S) {
+    if (S->heap != NULL) {
+        SmallRelease(S, S->heap, S->listsize);
+        S->heap = NULL;
+    }
+    S->length = 0;
+    S->listsize = SMALL_LIST_INLINE;
+}
+
+/**
+ * @brief Returns the number of elements in the list.
+ *
+ * @param S Pointer to the list.
+ * @return The number of elements.
+ */
+int SmallListLength(SmallList* S) {
+    return S->length;
+}
+
+/**
+ * @brief Retrieves the element at the specified position.
+ *
+ * @param S Pointer to the list.
+ * @param i The position (1-based index) of the element to retrieve.
+ * @param result Pointer to store the element if found.
+ * @return LIST_OK on success, LIST_ERR_POSITION if the position is invalid.
+ */
+int SmallOrderNum(SmallList* S, int i, ElemType* result) {
+    if (i < 1 || i > S->length) {
+        return LIST_ERR_POSITION;
+    }
+    *result = SmallListData(S)[i - 1];
+    return LIST_OK;
+}
+
+/**
+ * @brief Grows the capacity geometrically, spilling to the heap on the first call.
+ *
+ * @param S Pointer to the list.
+ * @return LIST_OK on success, LIST_ERR_FULL or LIST_ERR_NOMEM otherwise.
+ */
+static int SmallGrow(SmallList* S) {
+    int newsize = ListGrowCapacity(S->listsize);
+    if (newsize <= S->listsize) {
+        return LIST_ERR_FULL;
+    }
+    size_t size = (size_t)newsize * sizeof(ElemType);
+    ElemType* newbase;
+    if (S->heap == NULL) {
+        newbase = (ElemType*)(S->allocator != NULL ? S->allocator->allocate(S->allocator->ctx, size) : malloc(size));
+        if (newbase != NULL) {
+            memcpy(newbase, S->inlineElems, (size_t)S->length * sizeof(ElemType));
+        }
+    }
+    else if (S->allocator != NULL) {
+        size_t oldSize = (size_t)S->listsize * sizeof(ElemType);
+        newbase = (ElemType*)S->allocator->reallocate(S->allocator->ctx, S->heap, oldSize, size);
+    }
+    else {
+        newbase = (ElemType*)realloc(S->heap, size);
+    }
+    if (!newbase) {
+        return LIST_ERR_NOMEM;
+    }
+    S->heap = newbase;
+    S->listsize = newsize;
+    return LIST_OK;
+}
+
+/**
+ * @brief Inserts an element at the specified position.
+ *
+ * @param S Pointer to the list.
+ * @param i The position (1-based index) at which to insert the element.
+ * @param e The element to be inserted.
+ * @return LIST_OK on success, LIST_ERR_POSITION if 'i' is out of range,
+ *         LIST_ERR_FULL or LIST_ERR_NOMEM if the list could not grow.
+ */
+int SmallListInsert(SmallList* S, int i, ElemType e) {
+    if (i < 1 || i > S->length + 1) {
+        return LIST_ERR_POSITION;
+    }
+    if (S->length >= S->listsize) {
+        int status = SmallGrow(S);
+        if (status != LIST_OK) {
+            return status;
+        }
+    }
+    ElemType* q = SmallListData(S) + (i - 1);
+    memmove(q + 1, q, (size_t)(S->length - (i - 1)) * sizeof(ElemType));
+    *q = e;
+    S->length++;
+    return LIST_OK;
+}
+
+/**
+ * @brief Appends an element to the end of the list.
+ *
+ * @param S Pointer to the list.
+ * @param e The element to be appended.
+ * @return LIST_OK on success, LIST_ERR_FULL or LIST_ERR_NOMEM if the list could not grow.
+ */
+int SmallListAppend(SmallList* S, ElemType e) {
+    if (S->length >= S->listsize) {
+        int status = SmallGrow(S);
+        if (status != LIST_OK) {
+            return status;
+        }
+    }
+    SmallListData(S)[S->length++] = e;
+    return LIST_OK;
+}
+
+/**
+ * @brief Deletes the element at the specified position.
+ *
+ * A spilled list moves back to inline storage once it shrinks to half of
+ * SMALL_LIST_INLINE elements; the gap to the spill point avoids moving back
+ * and forth on alternating inserts and deletes.
+ *
+ * @param S Pointer to the list.
+ * @param i The position (1-based index) of the element to delete.
+ * @return LIST_OK on success, LIST_ERR_POSITION if 'i' is out of range.
+ */
+int SmallListDelete(SmallList* S, int i) {
+    if (i < 1 || i > S->length) {
+        return LIST_ERR_POSITION;
+    }
+    ElemType* q = SmallListData(S) + (i - 1);
+    memmove(q, q + 1, (size_t)(S->length - i) * sizeof(ElemType));
+    S->length--;
+    if (S->heap != NULL && S->length <= SMALL_LIST_INLINE / 2) {
+        memcpy(S->inlineElems, S->heap, (size_t)S->length * sizeof(ElemType));
+        SmallRelease(S, S->heap, S->listsize);
+        S->heap = NULL;
+        S->listsize = SMALL_LIST_INLINE;
+    }
+    return LIST_OK;
+}
+
+/**
+ * @brief Locates an element and returns its position.
+ *
+ * @param S Pointer to the list.
+ * @param e The element to locate.
+ * @return The position (1-based index) of the first element equal to 'e', or 0 if not found.
+ */
+int SmallLocateElem(SmallList* S, ElemType e) {
+    const ElemType* a = SmallListData(S);
+    for (int i = 0; i < S->length; i++) {
+        if (a[i] == e) {
+            return i + 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,125 @@
+#ifndef XPERANCE_SMALLLIST
+#define XPERANCE_SMALLLIST
+
+#include "SqList.h"
+
+/*
+ * Sequential list with inline storage for short lists.
+ *
+ * The first SMALL_LIST_INLINE elements live inside the structure itself,
+ * so creating a list and filling it up to that size performs no heap
+ * allocation at all. Only when it outgrows the inline buffer are the
+ * elements moved to heap storage, obtained through an optional
+ * ListAllocator. Positions are 1-based and the LIST_* status codes are
+ * returned, as for SqList.
+ */
+
+#ifndef SMALL_LIST_INLINE
+#define SMALL_LIST_INLINE 16 ///< Elements stored inside the structure before spilling to the heap (override with -D)
+#endif
+
+/**
+ * @brief The structure representing a list with inline storage.
+ *
+ * @heap Heap array once the list has spilled, NULL while the elements are inline.
+ * @length Current number of elements in the list.
+ * @listsize Current capacity (SMALL_LIST_INLINE while inline).
+ * @allocator Allocation hooks for the heap array, NULL for the C library.
+ * @inlineElems Inline element storage.
+ *
+ * The structure holds no pointer to itself, so it may be copied while
+ * inline; once spilled, a copy would share the heap array.
+ */
+typedef struct {
+    ElemType* heap; ///< Heap array after spilling, NULL while the elements are inline
+    int length; ///< Current number of elements in the list
+    int listsize; ///< Current capacity
+    const ListAllocator* allocator; ///< Storage hooks for 'heap', NULL for malloc/realloc/free
+    ElemType inlineElems[SMALL_LIST_INLINE]; ///< Inline element storage
+} SmallList;
+
+/**
+ * @brief Returns the element array of the list, wherever it currently lives.
+ *
+ * @param S Pointer to the list.
+ * @return Pointer to SmallListLength(S) contiguous elements; valid until the next insertion or deletion.
+ */
+static inline ElemType* SmallListData(SmallList* S) {
+    return S->heap != NULL ? S->heap : S->inlineElems;
+}
+
+/**
+ * @brief Initializes an empty list without allocating.
+ *
+ * @param S Pointer to the list to be initialized.
+ * @param allocator Hooks used if the list spills to the heap, or NULL for malloc/realloc/free.
+ */
+void InitSmallList(SmallList* S, const ListAllocator* allocator);
+
+/**
+ * @brief Releases the heap storage of the list, if any, and empties it.
+ *
+ * @param S Pointer to the list to be destroyed.
+ */
+void DestroySmallList(SmallList* S);
+
+/**
+ * @brief Returns the number of elements in the list.
+ *
+ * @param S Pointer to the list.
+ * @return The number of elements.
+ */
+int SmallListLength(SmallList* S);
+
+/**
+ * @brief Retrieves the element at the specified position.
+ *
+ * @param S Pointer to the list.
+ * @param i The position (1-based index) of the element to retrieve.
+ * @param result Pointer to store the element if found.
+ * @return LIST_OK on success, LIST_ERR_POSITION if the position is invalid.
+ */
+int SmallOrderNum(SmallList* S, int i, ElemType* result);
+
+/**
+ * @brief Inserts an element at the specified position.
+ *
+ * @param S Pointer to the list.
+ * @param i The position (1-based index) at which to insert the element.
+ * @param e The element to be inserted.
+ * @return LIST_OK on success, LIST_ERR_POSITION if 'i' is out of range,
+ *         LIST_ERR_FULL or LIST_ERR_NOMEM if the list could not grow.
+ */
+int SmallListInsert(SmallList* S, int i, ElemType e);
+
+/**
+ * @brief Appends an element to the end of the list.
+ *
+ * @param S Pointer to the list.
+ * @param e The element to be appended.
+ * @return LIST_OK on success, LIST_ERR_FULL or LIST_ERR_NOMEM if the list could not grow.
+ */
+int SmallListAppend(SmallList* S, ElemType e);
+
+/**
+ * @brief Deletes the element at the specified position.
+ *
+ * A spilled list moves back to inline storage once it shrinks to half of
+ * SMALL_LIST_INLINE elements.
+ *
+ * @param S Pointer to the list.
+ * @param i The position (1-based index) of the element to delete.
+ * @return LIST_OK on success, LIST_ERR_POSITION if 'i' is out of range.
+ */
+int SmallListDelete(SmallList* S, int i);
+
+/**
+ * @brief Locates an element and returns its position.
+ *
+ * @param S Pointer to the list.
+ * @param e The element to locate.
+ * @return The position (1-based index) of the first element equal to 'e', or 0 if not found.
+ */
+int SmallLocateElem(SmallList* S, ElemType e);
+
+#endif
@@ -0,0 +1,233 @@
+#include "SortedList.h"
+#include <limits.h>
+#include <stddef.h>
+
+/**
+ * @brief Returns the index of the first element of a[0, n) that is not less than 'e'.
+ *
+ * The loop halves the range without a data-dependent branch: the comparison
+ * result (0 or 1) scales the step, so the compiler emits a set/conditional
+ * move rather than a jump, and the running time does not depend on how
+ * well the branch predictor guesses the search path.
+ *
+ * @param a Sorted array.
+ * @param n Number of elements in the array.
+ * @param e The value to search for.
+ * @return The lower bound of 'e' in [0, n].
+ */
+static int LowerBound(const ElemType* a, int n, ElemType e) {
+    if (n == 0) {
+        return 0;
+    }
+    const ElemType* base = a;
+    while (n > 1) {
+        int half = n / 2;
+        base += (base[half - 1] < e) * half;
+        n -= half;
+    }
+    return (int)(base - a) + (*base < e);
+}
+
+/**
+ * @brief Returns the index of the first element of a[0, n) that is greater than 'e'.
+ *
+ * Same branchless scheme as LowerBound.
+ *
+ * @param a Sorted array.
+ * @param n Number of elements in the array.
+ * @param e The value to search for.
+ * @return The upper bound of 'e' in [0, n].
+ */
+static int UpperBound(const ElemType* a, int n, ElemType e) {
+    if (n == 0) {
+        return 0;
+    }
+    const ElemType* base = a;
+    while (n > 1) {
+        int half = n / 2;
+        base += (base[half - 1] <= e) * half;
+        n -= half;
+    }
+    return (int)(base - a) + (*base <= e);
+}
+
+/**
+ * @brief Returns the number of elements less than 'e' (the lower bound).
+ *
+ * @param L Pointer to a sorted list.
+ * @param e The value to search for.
+ * @return The 0-based index of the first element not less than 'e', or the length if there is none.
+ */
+int SortedLowerBound(SqList* L, ElemType e) {
+    return LowerBound(L->elem, L->length, e);
+}
+
+/**
+ * @brief Returns the number of elements less than or equal to 'e' (the upper bound).
+ *
+ * @param L Pointer to a sorted list.
+ * @param e The value to search for.
+ * @return The 0-based index of the first element greater than 'e', or the length if there is none.
+ */
+int SortedUpperBound(SqList* L, ElemType e) {
+    return UpperBound(L->elem, L->length, e);
+}
+
+/**
+ * @brief Checks whether the list is in ascending order.
+ *
+ * @param L Pointer to the list.
+ * @return TRUE if every element is less than or equal to its successor, otherwise FALSE.
+ */
+int SortedCheck(SqList* L) {
+    for (int i = 1; i < L->length; i++) {
+        if (L->elem[i] < L->elem[i - 1]) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/**
+ * @brief Inserts an element at its ordered position.
+ *
+ * The slot is found by binary search; the tail is then shifted by
+ * ListInsert, so the insertion costs O(log n) comparisons plus one memmove.
+ *
+ * @param L Pointer to a sorted list.
+ * @param e The element to insert.
+ * @return LIST_OK on success, otherwise the error from ListInsert.
+ */
+int SortedInsert(SqList* L, ElemType e) {
+    return ListInsert(L, UpperBound(L->elem, L->length, e) + 1, e);
+}
+
+/**
+ * @brief Merges a sorted batch of elements into the list in O(n + k).
+ *
+ * The list grows once, then the two sequences are merged from the back into
+ * the enlarged array, so no element moves more than once. Elements already
+ * in the list come before equal elements from the batch. Only the part of
+ * the list above the smallest new element is touched.
+ *
+ * @param L Pointer to a sorted list.
+ * @param src The elements to insert, in ascending order; must not point into the list itself.
+ * @param k The number of elements to insert.
+ * @return LIST_OK on success, LIST_ERR_FULL if 'k' is negative or would overflow
+ *         the length, LIST_ERR_NOMEM if the list could not grow.
+ */
+int SortedInsertBatch(SqList* L, const ElemType* src, int k) {
+    if (k < 0 || k > INT_MAX - L->length) {
+        return LIST_ERR_FULL;
+    }
+    if (k == 0) {
+        return LIST_OK;
+    }
+    int needed = L->length + k;
+    int status = ListEnsureCapacity(L, needed);
+    if (status != LIST_OK) {
+        return status;
+    }
+    ElemType* a = L->elem;
+    int stop = UpperBound(a, L->length, src[0]);
+    int i = L->length - 1;
+    int j = k - 1;
+    int w = needed - 1;
+    while (j >= 0) {
+        if (i >= stop && a[i] > src[j]) {
+            a[w--] = a[i--];
+        }
+        else {
+            a[w--] = src[j--];
+        }
+    }
+    L->length = needed;
+    ListInvalidateIndex(L);
+    return LIST_OK;
+}
+
+/**
+ * @brief Deletes the first element equal to 'e'.
+ *
+ * @param L Pointer to a sorted list.
+ * @param e The value to delete.
+ * @return LIST_OK on success, LIST_ERR_NOT_FOUND if 'e' is not in the list.
+ */
+int SortedDelete(SqList* L, ElemType e) {
+    int pos = SortedLocate(L, e);
+    if (pos == 0) {
+        return LIST_ERR_NOT_FOUND;
+    }
+    return ListDelete(L, pos);
+}
+
+/**
+ * @brief Locates an element in O(log n).
+ *
+ * @param L Pointer to a sorted list.
+ * @param e The element to locate.
+ * @return The position (1-based index) of the first element equal to 'e', or 0 if not found.
+ */
+int SortedLocate(SqList* L, ElemType e) {
+    int i = LowerBound(L->elem, L->length, e);
+    if (i < L->length && L->elem[i] == e) {
+        return i + 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Returns the largest element less than 'e'.
+ *
+ * @param L Pointer to a sorted list.
+ * @param e The reference value; it need not be in the list.
+ * @param result Pointer to store the predecessor, if found.
+ * @return LIST_OK if a predecessor exists, otherwise LIST_ERR_NO_PRIOR.
+ */
+int SortedPrior(SqList* L, ElemType e, ElemType* result) {
+    int i = LowerBound(L->elem, L->length, e);
+    if (i == 0) {
+        return LIST_ERR_NO_PRIOR;
+    }
+    *result = L->elem[i - 1];
+    return LIST_OK;
+}
+
+/**
+ * @brief Returns the smallest element greater than 'e'.
+ *
+ * @param L Pointer to a sorted list.
+ * @param e The reference value; it need not be in the list.
+ * @param result Pointer to store the successor, if found.
+ * @return LIST_OK if a successor exists, otherwise LIST_ERR_NO_NEXT.
+ */
+int SortedNext(SqList* L, ElemType e, ElemType* result) {
+    int i = UpperBound(L->elem, L->length, e);
+    if (i == L->length) {
+        return LIST_ERR_NO_NEXT;
+    }
+    *result = L->elem[i];
+    return LIST_OK;
+}
+
+/**
+ * @brief Finds the elements in the closed range [lo, hi].
+ *
+ * Two binary searches; the matching elements are L->elem[*first - 1] onwards.
+ *
+ * @param L Pointer to a sorted list.
+ * @param lo The smallest value of the range.
+ * @param hi The largest value of the range.
+ * @param first Pointer to store the position (1-based index) of the first
+ *              element in the range; set to length + 1 if the range is empty.
+ *              May be NULL.
+ * @return The number of elements in the range.
+ */
+int SortedRange(SqList* L, ElemType lo, ElemType hi, int* first) {
+    int begin = LowerBound(L->elem, L->length, lo);
+    int end = hi < lo ? begin : UpperBound(L->elem + begin, L->length - begin, hi) + begin;
+    if (first != NULL) {
+        *first = begin < end ? begin + 1 : L->length + 1;
+    }
+    return end - begin;
+}
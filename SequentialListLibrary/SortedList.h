@@ -0,0 +1,119 @@
+#ifndef XPERANCE_SORTEDLIST
+#define XPERANCE_SORTEDLIST
+
+#include "SqList.h"
+
+/*
+ * Operations for a SqList kept in ascending order.
+ *
+ * These functions take an ordinary SqList and rely on its elements being
+ * sorted; they keep it sorted. Searches use a branchless lower bound, so
+ * locating a value, its neighbours by value, or a value range is O(log n).
+ * The plain SqList functions may still be used for reading, and for
+ * deleting by position, which preserves the order.
+ */
+
+/**
+ * @brief Returns the number of elements less than 'e' (the lower bound).
+ *
+ * @param L Pointer to a sorted list.
+ * @param e The value to search for.
+ * @return The 0-based index of the first element not less than 'e', or the length if there is none.
+ */
+int SortedLowerBound(SqList* L, ElemType e);
+
+/**
+ * @brief Returns the number of elements less than or equal to 'e' (the upper bound).
+ *
+ * @param L Pointer to a sorted list.
+ * @param e The value to search for.
+ * @return The 0-based index of the first element greater than 'e', or the length if there is none.
+ */
+int SortedUpperBound(SqList* L, ElemType e);
+
+/**
+ * @brief Checks whether the list is in ascending order.
+ *
+ * @param L Pointer to the list.
+ * @return TRUE if every element is less than or equal to its successor, otherwise FALSE.
+ */
+int SortedCheck(SqList* L);
+
+/**
+ * @brief Inserts an element at its ordered position.
+ *
+ * Equal elements keep their insertion order: 'e' goes after any element equal to it.
+ *
+ * @param L Pointer to a sorted list.
+ * @param e The element to insert.
+ * @return LIST_OK on success, otherwise the error from ListInsert.
+ */
+int SortedInsert(SqList* L, ElemType e);
+
+/**
+ * @brief Merges a sorted batch of elements into the list in O(n + k).
+ *
+ * @param L Pointer to a sorted list.
+ * @param src The elements to insert, in ascending order; must not point into the list itself.
+ * @param k The number of elements to insert.
+ * @return LIST_OK on success, LIST_ERR_FULL if 'k' is negative or would overflow
+ *         the length, LIST_ERR_NOMEM if the list could not grow.
+ */
+int SortedInsertBatch(SqList* L, const ElemType* src, int k);
+
+/**
+ * @brief Deletes the first element equal to 'e'.
+ *
+ * @param L Pointer to a sorted list.
+ * @param e The value to delete.
+ * @return LIST_OK on success, LIST_ERR_NOT_FOUND if 'e' is not in the list.
+ */
+int SortedDelete(SqList* L, ElemType e);
+
+/**
+ * @brief Locates an element in O(log n).
+ *
+ * @param L Pointer to a sorted list.
+ * @param e The element to locate.
+ * @return The position (1-based index) of the first element equal to 'e', or 0 if not found.
+ */
+int SortedLocate(SqList* L, ElemType e);
+
+/**
+ * @brief Returns the largest element less than 'e'.
+ *
+ * 'e' itself need not be in the list.
+ *
+ * @param L Pointer to a sorted list.
+ * @param e The reference value.
+ * @param result Pointer to store the predecessor, if found.
+ * @return LIST_OK if a predecessor exists, otherwise LIST_ERR_NO_PRIOR.
+ */
+int SortedPrior(SqList* L, ElemType e, ElemType* result);
+
+/**
+ * @brief Returns the smallest element greater than 'e'.
+ *
+ * 'e' itself need not be in the list.
+ *
+ * @param L Pointer to a sorted list.
+ * @param e The reference value.
+ * @param result Pointer to store the successor, if found.
+ * @return LIST_OK if a successor exists, otherwise LIST_ERR_NO_NEXT.
+ */
+int SortedNext(SqList* L, ElemType e, ElemType* result);
+
+/**
+ * @brief Finds the elements in the closed range [lo, hi].
+ *
+ * @param L Pointer to a sorted list.
+ * @param lo The smallest value of the range.
+ * @param hi The largest value of the range.
+ * @param first Pointer to store the position (1-based index) of the first
+ *              element in the range; set to length + 1 if the range is empty.
+ *              May be NULL.
+ * @return The number of elements in the range.
+ */
+int SortedRange(SqList* L, ElemType lo, ElemType hi, int* first);
+
+#endif
@@ -1,6 +1,114 @@
 #include "SqList.h"
 #include <stdio.h>
+#include <limits.h>
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SQLIST_SIMD_X86 1 ///< Build the SSE2/AVX2 scan kernels
+#include <immintrin.h>
+#endif
+
+static ListLogHook logHook = NULL; ///< Diagnostics sink installed by SetListLogHook; NULL means silent
+
+/**
+ * @brief Installs a callback that receives the list's diagnostic messages.
+ *
+ * The hook is process-wide. With no hook installed (the default) the list
+ * functions perform no I/O at all; failures are reported only through their
+ * status codes.
+ *
+ * @param hook The callback to install, or NULL to silence diagnostics again.
+ */
+void SetListLogHook(ListLogHook hook) {
+    logHook = hook;
+}
+
+/**
+ * @brief Returns a short human-readable description of a status code.
+ *
+ * @param status A LIST_OK or LIST_ERR_* value.
+ * @return A static string describing the status.
+ */
+const char* ListStatusString(int status) {
+    switch (status) {
+    case LIST_OK:            return "success";
+    case LIST_UNCHANGED:     return "no change";
+    case LIST_ERR_POSITION:  return "invalid position";
+    case LIST_ERR_NOMEM:     return "memory allocation failed";
+    case LIST_ERR_FULL:      return "capacity limit reached";
+    case LIST_ERR_NOT_FOUND: return "element not found";
+    case LIST_ERR_NO_PRIOR:  return "no predecessor";
+    case LIST_ERR_NO_NEXT:   return "no successor";
+    case LIST_ERR_IO:        return "file operation failed";
+    case LIST_ERR_FORMAT:    return "not a list file";
+    case LIST_ERR_CHECKSUM:  return "checksum mismatch";
+    default:                 return "unknown status";
+    }
+}
+
+/**
+ * @brief Formats a diagnostic and passes it to the installed hook, if any.
+ *
+ * Returns before touching the format string when no hook is installed, so a
+ * silent list pays only for one pointer test.
+ *
+ * @param status The status code the message describes.
+ * @param format printf-style format of the message.
+ */
+static void ListLog(int status, const char* format, ...) {
+    if (logHook == NULL) {
+        return;
+    }
+    char message[128];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(message, sizeof(message), format, args);
+    va_end(args);
+    logHook(status, message);
+}
+
+/**
+ * @brief Allocates an element array of 'count' elements for the list.
+ *
+ * Uses the list's allocator if it has one, otherwise malloc.
+ */
+static ElemType* ElemAllocate(SqList* L, int count) {
+    size_t size = (size_t)count * sizeof(ElemType);
+    if (L->allocator != NULL) {
+        return (ElemType*)L->allocator->allocate(L->allocator->ctx, size);
+    }
+    return (ElemType*)malloc(size);
+}
+
+/**
+ * @brief Resizes the list's element array from L->listsize to 'count' elements.
+ *
+ * @return The new array, or NULL if it could not be resized (the old one stays valid).
+ */
+static ElemType* ElemReallocate(SqList* L, int count) {
+    size_t size = (size_t)count * sizeof(ElemType);
+    if (L->allocator != NULL) {
+        size_t oldSize = (size_t)L->listsize * sizeof(ElemType);
+        return (ElemType*)L->allocator->reallocate(L->allocator->ctx, L->elem, oldSize, size);
+    }
+    return (ElemType*)realloc(L->elem, size);
+}
+
+/**
+ * @brief Releases the list's element array.
+ */
+static void ElemRelease(SqList* L) {
+    if (L->allocator != NULL) {
+        L->allocator->release(L->allocator->ctx, L->elem, (size_t)L->listsize * sizeof(ElemType));
+    }
+    else {
+        free(L->elem);
+    }
+}
 
 /**
  * @brief Initializes a new sequential list.
@@ -10,13 +118,62 @@
  * @param L Pointer to the list to be initialized.
  */
 void InitList(SqList* L) {
-    L->elem = (ElemType*)malloc(LIST_INIT_SIZE * sizeof(ElemType));
+    L->allocator = NULL;
+    L->elem = ElemAllocate(L, LIST_INIT_SIZE);
     if (!L->elem) {
-        printf("Memory allocation failed\n");
+        ListLog(LIST_ERR_NOMEM, "Memory allocation failed");
+        L->length = 0;
+        L->listsize = 0;
+        L->index = NULL;
         return;
     }
     L->length = 0;
     L->listsize = LIST_INIT_SIZE;
+    L->index = NULL;
+}
+
+/**
+ * @brief Initializes a new sequential list with room for at least 'capacity' elements.
+ *
+ * Use this instead of InitList when the final size is roughly known, so that
+ * filling the list never has to reallocate.
+ *
+ * @param L Pointer to the list to be initialized.
+ * @param capacity The number of elements to allocate up front (LIST_INIT_SIZE if less than 1).
+ * @return LIST_OK on success, LIST_ERR_NOMEM if the allocation failed.
+ */
+int InitListWithCapacity(SqList* L, int capacity) {
+    return InitListWithAllocator(L, capacity, NULL);
+}
+
+/**
+ * @brief Initializes a new sequential list whose elements are stored through 'allocator'.
+ *
+ * Every later allocation, resize and release of the element array goes
+ * through the allocator's hooks, for example to take per-request lists from
+ * a ListArena. The allocator must outlive the list. Auxiliary memory (the
+ * hash index, partition buffers) still comes from malloc.
+ *
+ * @param L Pointer to the list to be initialized.
+ * @param capacity The number of elements to allocate up front (LIST_INIT_SIZE if less than 1).
+ * @param allocator The allocation hooks, or NULL for malloc/realloc/free.
+ * @return LIST_OK on success, LIST_ERR_NOMEM if the allocation failed.
+ */
+int InitListWithAllocator(SqList* L, int capacity, const ListAllocator* allocator) {
+    if (capacity < 1) {
+        capacity = LIST_INIT_SIZE;
+    }
+    L->allocator = allocator;
+    L->index = NULL;
+    L->length = 0;
+    L->elem = ElemAllocate(L, capacity);
+    if (!L->elem) {
+        ListLog(LIST_ERR_NOMEM, "Memory allocation failed");
+        L->listsize = 0;
+        return LIST_ERR_NOMEM;
+    }
+    L->listsize = capacity;
+    return LIST_OK;
 }
 
 /**
@@ -53,121 +210,778 @@ int LengthList(SqList* L) {
  * @param L Pointer to the list.
  * @param i The position (1-based index) of the element to retrieve.
  * @param result Pointer to store the element if found.
- * @return TRUE if the element exists at the specified position, FALSE if the position is invalid.
+ * @return LIST_OK if the element exists at the specified position, LIST_ERR_POSITION if the position is invalid.
  */
 int OrderNum(SqList* L, int i, ElemType* result) {
     if (i < 1 || i > L->length) {
-        printf("Invalid position\n");
-        return FALSE;
+        ListLog(LIST_ERR_POSITION, "Invalid position %d", i);
+        return LIST_ERR_POSITION;
     }
     *result = L->elem[i - 1];
-    return TRUE;
+    return LIST_OK;
+}
+
+
+/**
+ * @brief Computes the capacity to grow to from the current one.
+ *
+ * Grows by LIST_GROWTH_FACTOR but at least by LISTINCREMENT, and never past
+ * INT_MAX. This is the growth policy of every list in the library.
+ *
+ * @param listsize The current capacity.
+ * @return The new capacity, or 'listsize' if the list cannot grow any further.
+ */
+int ListGrowCapacity(int listsize) {
+    double grown = (double)listsize * LIST_GROWTH_FACTOR;
+    if (grown < (double)listsize + LISTINCREMENT) {
+        grown = (double)listsize + LISTINCREMENT;
+    }
+    if (grown > (double)INT_MAX) {
+        grown = (double)INT_MAX;
+    }
+    return (int)grown;
 }
 
+/**
+ * @brief Computes the capacity to shrink to for 'length' elements.
+ *
+ * Once fewer than 1/LIST_SHRINK_THRESHOLD of the capacity is used, divides
+ * it by LIST_SHRINK_FACTOR as often as that still holds, never below
+ * LIST_INIT_SIZE. This is the shrink policy of every list in the library.
+ *
+ * @param length The number of elements in use.
+ * @param listsize The current capacity.
+ * @return The new capacity, or 'listsize' if no shrink is due.
+ */
+int ListShrinkCapacity(int length, int listsize) {
+    if (listsize <= LIST_INIT_SIZE || length >= listsize / LIST_SHRINK_THRESHOLD) {
+        return listsize;
+    }
+    int newsize = listsize / LIST_SHRINK_FACTOR;
+    while (newsize > LIST_INIT_SIZE && length < newsize / LIST_SHRINK_THRESHOLD) {
+        newsize /= LIST_SHRINK_FACTOR;
+    }
+    return newsize < LIST_INIT_SIZE ? LIST_INIT_SIZE : newsize;
+}
 
 /**
- * @brief Expands the size of the list by a defined increment.
+ * @brief Expands the capacity of the list geometrically.
  *
- * Allocates additional memory to the list to allow for more elements.
+ * Allocates additional memory to the list to allow for more elements. The
+ * capacity is multiplied by LIST_GROWTH_FACTOR rather than increased by a
+ * fixed step, so building a list of n elements with ListInsert or ListAppend
+ * copies O(n) elements in total instead of O(n^2).
  *
  * @param L Pointer to the list.
- * @return TRUE if expansion is successful, otherwise FALSE.
+ * @return LIST_OK on success, LIST_ERR_FULL if the capacity is already INT_MAX,
+ *         LIST_ERR_NOMEM if the reallocation failed.
  */
 int ExpandList(SqList* L) {
-    ElemType* newbase = (ElemType*)realloc(L->elem, (L->listsize + LISTINCREMENT) * sizeof(ElemType));
+    int newsize = ListGrowCapacity(L->listsize);
+    if (newsize <= L->listsize) {
+        ListLog(LIST_ERR_FULL, "Expansion failed: capacity limit reached");
+        return LIST_ERR_FULL;
+    }
+    ElemType* newbase = ElemReallocate(L, newsize);
     if (!newbase) {
-        printf("Expansion failed\n");
-        return FALSE;
+        ListLog(LIST_ERR_NOMEM, "Expansion failed");
+        return LIST_ERR_NOMEM;
+    }
+    L->elem = newbase;
+    L->listsize = newsize;
+    ListLog(LIST_OK, "Expansion successful, new capacity: %d", L->listsize);
+    return LIST_OK;
+}
+
+/**
+ * @brief Ensures the list can hold at least 'capacity' elements without reallocating.
+ *
+ * Reallocates at most once, to exactly 'capacity' elements. Does nothing if
+ * the list is already large enough.
+ *
+ * @param L Pointer to the list.
+ * @param capacity The minimum capacity required.
+ * @return LIST_OK if the capacity is now at least 'capacity', LIST_ERR_NOMEM otherwise.
+ */
+int ReserveList(SqList* L, int capacity) {
+    if (capacity <= L->listsize) {
+        return LIST_OK;
+    }
+    ElemType* newbase = ElemReallocate(L, capacity);
+    if (!newbase) {
+        ListLog(LIST_ERR_NOMEM, "Reservation of %d elements failed", capacity);
+        return LIST_ERR_NOMEM;
     }
     L->elem = newbase;
-    L->listsize += LISTINCREMENT;
-    printf("Expansion successful, new capacity: %d\n", L->listsize);
-    return TRUE;
+    L->listsize = capacity;
+    return LIST_OK;
 }
 
 /**
- * @brief Shrinks the size of the list by a defined decrement if necessary.
+ * @brief Shrinks the capacity of the list if it is mostly empty.
  *
- * Releases excess memory if the list's capacity is much larger than its length.
+ * Releases excess memory only once fewer than 1/LIST_SHRINK_THRESHOLD of the
+ * capacity is in use. The capacity is then divided by LIST_SHRINK_FACTOR as
+ * many times as that rule still holds (never below LIST_INIT_SIZE), and the
+ * list is reallocated once to the result, so a bulk delete returns all the
+ * excess at once. The gap between the shrink point and the next growth
+ * point means alternating inserts and deletes near a boundary cannot make
+ * every operation reallocate.
  *
  * @param L Pointer to the list.
- * @return TRUE if shrinkage is successful, otherwise FALSE.
+ * @return LIST_OK if the capacity was reduced, LIST_UNCHANGED if no shrink was
+ *         due, LIST_ERR_NOMEM if the reallocation failed (the list is left intact).
  */
 int ShrinkList(SqList* L) {
-    if (L->listsize - LISTDECREMENT >= L->length) {
-        ElemType* newbase = (ElemType*)realloc(L->elem, (L->listsize - LISTDECREMENT) * sizeof(ElemType));
-        if (!newbase) {
-            printf("Shrinkage failed\n");
-            return FALSE;
+    int newsize = ListShrinkCapacity(L->length, L->listsize);
+    if (newsize == L->listsize) {
+        return LIST_UNCHANGED;
+    }
+    ElemType* newbase = ElemReallocate(L, newsize);
+    if (!newbase) {
+        ListLog(LIST_ERR_NOMEM, "Shrinkage failed");
+        return LIST_ERR_NOMEM;
+    }
+    L->elem = newbase;
+    L->listsize = newsize;
+    ListLog(LIST_OK, "Shrinkage successful, new capacity: %d", L->listsize);
+    return LIST_OK;
+}
+
+/**
+ * @brief Reduces the capacity of the list to its current length.
+ *
+ * Use after the list has reached its final size to return all spare memory.
+ * A list is never shrunk below one element.
+ *
+ * @param L Pointer to the list.
+ * @return LIST_OK if the capacity now equals the length (or 1 for an empty list),
+ *         LIST_ERR_NOMEM if the reallocation failed.
+ */
+int ShrinkToFit(SqList* L) {
+    int newsize = L->length > 0 ? L->length : 1;
+    if (newsize == L->listsize) {
+        return LIST_OK;
+    }
+    ElemType* newbase = ElemReallocate(L, newsize);
+    if (!newbase) {
+        ListLog(LIST_ERR_NOMEM, "Shrink to fit failed");
+        return LIST_ERR_NOMEM;
+    }
+    L->elem = newbase;
+    L->listsize = newsize;
+    return LIST_OK;
+}
+
+/*
+ * Optional hash index from element value to the position of its first
+ * occurrence. It is an open-addressing table with linear probing and a
+ * multiplicative hash, kept at most half full. Appending to the list and
+ * deleting its last element update the index in place; any other change
+ * only marks it dirty, and the next lookup rebuilds it in O(n). A batch of
+ * edits therefore costs one rebuild, and lookups on a list that no longer
+ * changes are O(1).
+ */
+
+#define LIST_INDEX_MIN_SLOTS 16 ///< Smallest hash table allocated for an index
+
+typedef struct {
+    ElemType key; ///< Element value
+    int pos; ///< 0-based position of the first occurrence of 'key', or -1 for an empty slot
+} ListIndexSlot;
+
+struct ListIndex {
+    ListIndexSlot* slots; ///< Hash table, 'capacity' entries
+    int capacity; ///< Number of slots, a power of two
+    int count; ///< Number of occupied slots
+    int shift; ///< 32 - log2(capacity), turns the 32-bit hash into a slot number
+    int dirty; ///< Nonzero if the table no longer matches the list
+};
+
+/**
+ * @brief Returns the home slot of 'key' (Fibonacci hashing on the value's bits).
+ */
+static int IndexHome(const struct ListIndex* index, ElemType key) {
+    return (int)(((uint32_t)key * 2654435769u) >> index->shift);
+}
+
+/**
+ * @brief Returns the slot holding 'key', or the empty slot where it would go.
+ */
+static int IndexProbe(const struct ListIndex* index, ElemType key) {
+    int mask = index->capacity - 1;
+    int s = IndexHome(index, key);
+    while (index->slots[s].pos >= 0 && index->slots[s].key != key) {
+        s = (s + 1) & mask;
+    }
+    return s;
+}
+
+/**
+ * @brief Marks the index of 'L', if any, as out of date.
+ */
+static void IndexInvalidate(SqList* L) {
+    if (L->index != NULL) {
+        L->index->dirty = 1;
+    }
+}
+
+/**
+ * @brief Refills the index from the list, resizing the table to twice the length.
+ *
+ * @return LIST_OK on success, LIST_ERR_NOMEM if the table could not be
+ *         allocated (the index stays dirty and lookups fall back to scanning).
+ */
+static int IndexRebuild(SqList* L) {
+    struct ListIndex* index = L->index;
+    int capacity = LIST_INDEX_MIN_SLOTS;
+    int bits = 4;
+    while (capacity / 2 < L->length && capacity < (1 << 30)) {
+        capacity <<= 1;
+        bits++;
+    }
+    if (capacity != index->capacity) {
+        ListIndexSlot* slots = (ListIndexSlot*)malloc((size_t)capacity * sizeof(ListIndexSlot));
+        if (!slots) {
+            ListLog(LIST_ERR_NOMEM, "Index rebuild failed");
+            index->dirty = 1;
+            return LIST_ERR_NOMEM;
+        }
+        free(index->slots);
+        index->slots = slots;
+        index->capacity = capacity;
+        index->shift = 32 - bits;
+    }
+    for (int s = 0; s < index->capacity; s++) {
+        index->slots[s].pos = -1;
+    }
+    index->count = 0;
+    for (int i = 0; i < L->length; i++) {
+        int s = IndexProbe(index, L->elem[i]);
+        if (index->slots[s].pos < 0) {
+            index->slots[s].key = L->elem[i];
+            index->slots[s].pos = i;
+            index->count++;
         }
-        L->elem = newbase;
-        L->listsize -= LISTDECREMENT;
-        printf("Shrinkage successful, new capacity: %d\n", L->listsize);
-        return TRUE;
     }
-    return FALSE;
+    index->dirty = 0;
+    return LIST_OK;
+}
+
+/**
+ * @brief Records that 'L->elem[pos]' was just appended.
+ *
+ * Marks the index dirty instead when the table would become more than half
+ * full; the next lookup then rebuilds it with a larger table.
+ */
+static void IndexAppend(SqList* L, int pos) {
+    struct ListIndex* index = L->index;
+    if (index == NULL || index->dirty) {
+        return;
+    }
+    int s = IndexProbe(index, L->elem[pos]);
+    if (index->slots[s].pos >= 0) {
+        return;
+    }
+    if (index->count + 1 > index->capacity / 2) {
+        index->dirty = 1;
+        return;
+    }
+    index->slots[s].key = L->elem[pos];
+    index->slots[s].pos = pos;
+    index->count++;
+}
+
+/**
+ * @brief Records that the last element, 'key' at position 'pos', is about to be removed.
+ *
+ * The slot is deleted by shifting later members of its probe run back, so
+ * the table needs no tombstones.
+ */
+static void IndexRemoveLast(SqList* L, ElemType key, int pos) {
+    struct ListIndex* index = L->index;
+    if (index == NULL || index->dirty) {
+        return;
+    }
+    int s = IndexProbe(index, key);
+    if (index->slots[s].pos != pos) {
+        return; // 'key' also occurs earlier, so its entry stays
+    }
+    int mask = index->capacity - 1;
+    int hole = s;
+    for (int next = (hole + 1) & mask; index->slots[next].pos >= 0; next = (next + 1) & mask) {
+        int home = IndexHome(index, index->slots[next].key);
+        // Move the entry back unless its home lies cyclically in (hole, next].
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            index->slots[hole] = index->slots[next];
+            hole = next;
+        }
+    }
+    index->slots[hole].pos = -1;
+    index->count--;
+}
+
+/**
+ * @brief Looks up the first position of 'e' through the index.
+ *
+ * @return The 0-based position, -1 if 'e' is not in the list, or -2 if the
+ *         list has no usable index and must be scanned.
+ */
+static int IndexLookup(SqList* L, ElemType e) {
+    struct ListIndex* index = L->index;
+    if (index == NULL || (index->dirty && IndexRebuild(L) != LIST_OK)) {
+        return -2;
+    }
+    return index->slots[IndexProbe(index, e)].pos;
+}
+
+/**
+ * @brief Attaches a hash index to the list for O(1) value lookups.
+ *
+ * LocateElem, PriorElem and NextElem then consult the index instead of
+ * scanning. The list functions keep it consistent. Code that writes to
+ * L->elem directly must call ListInvalidateIndex afterwards. The table is
+ * built on the first lookup, and costs about 16 bytes per distinct value.
+ *
+ * @param L Pointer to the list.
+ * @return LIST_OK on success (or if an index already exists), LIST_ERR_NOMEM otherwise.
+ */
+int ListEnableIndex(SqList* L) {
+    if (L->index != NULL) {
+        return LIST_OK;
+    }
+    struct ListIndex* index = (struct ListIndex*)malloc(sizeof(struct ListIndex));
+    if (!index) {
+        ListLog(LIST_ERR_NOMEM, "Index allocation failed");
+        return LIST_ERR_NOMEM;
+    }
+    index->slots = NULL;
+    index->capacity = 0;
+    index->count = 0;
+    index->shift = 0;
+    index->dirty = 1;
+    L->index = index;
+    return LIST_OK;
+}
+
+/**
+ * @brief Detaches and frees the hash index of the list, if any.
+ *
+ * @param L Pointer to the list.
+ */
+void ListDisableIndex(SqList* L) {
+    if (L->index != NULL) {
+        free(L->index->slots);
+        free(L->index);
+        L->index = NULL;
+    }
+}
+
+/**
+ * @brief Tells the index that the elements were modified outside the list functions.
+ *
+ * The index is rebuilt on the next lookup.
+ *
+ * @param L Pointer to the list.
+ */
+void ListInvalidateIndex(SqList* L) {
+    IndexInvalidate(L);
 }
 
 /**
  * @brief Inserts an element at the specified position in the list.
  *
- * Shifts subsequent elements to the right to make space for the new element.
+ * Shifts subsequent elements to the right (with a single memmove) to make space for the new element.
  *
  * @param L Pointer to the list.
  * @param i The position (1-based index) at which to insert the element.
  * @param e The element to be inserted.
- * @return TRUE if the insertion is successful, otherwise FALSE.
+ * @return LIST_OK on success, LIST_ERR_POSITION if 'i' is out of range, or
+ *         the error from ExpandList if the list could not grow.
  */
 int ListInsert(SqList* L, int i, ElemType e) {
     if (i < 1 || i > L->length + 1) {
-        printf("Invalid insertion position\n");
-        return FALSE;
+        ListLog(LIST_ERR_POSITION, "Invalid insertion position %d", i);
+        return LIST_ERR_POSITION;
     }
     // Check if expansion is needed
     if (L->length >= L->listsize) {
-        if (ExpandList(L) == FALSE) {
-            printf("Failed to expand the list during insertion\n");
-            return FALSE;
+        int status = ExpandList(L);
+        if (status != LIST_OK) {
+            return status;
         }
     }
     ElemType* q = &(L->elem[i - 1]);
-    ElemType* p = &(L->elem[L->length - 1]);
-    for (p = &(L->elem[L->length - 1]); p >= q; --p) {
-        *(p + 1) = *p;
-    }
+    memmove(q + 1, q, (size_t)(L->length - (i - 1)) * sizeof(ElemType));
     *q = e;
     L->length++;
-    return TRUE;
+    if (i == L->length) {
+        IndexAppend(L, i - 1);
+    }
+    else {
+        IndexInvalidate(L);
+    }
+    return LIST_OK;
+}
+
+/**
+ * @brief Appends an element to the end of the list in amortized O(1) time.
+ *
+ * Equivalent to ListInsert(L, LengthList(L) + 1, e), without the position
+ * check and the element-shifting loop.
+ *
+ * @param L Pointer to the list.
+ * @param e The element to be appended.
+ * @return LIST_OK on success, or the error from ExpandList if the list could not grow.
+ */
+int ListAppend(SqList* L, ElemType e) {
+    if (L->length >= L->listsize) {
+        int status = ExpandList(L);
+        if (status != LIST_OK) {
+            return status;
+        }
+    }
+    L->elem[L->length++] = e;
+    IndexAppend(L, L->length - 1);
+    return LIST_OK;
 }
 
 /**
  * @brief Deletes the element at the specified position in the list.
  *
- * Shifts subsequent elements to the left to fill the gap left by the deleted element.
+ * Shifts subsequent elements to the left (with a single memmove) to fill the gap left by the deleted element.
  *
  * @param L Pointer to the list.
  * @param i The position (1-based index) of the element to delete.
- * @return TRUE if the deletion is successful, otherwise FALSE.
+ * @return LIST_OK on success, LIST_ERR_POSITION if 'i' is out of range.
  */
 int ListDelete(SqList* L, int i) {
     if (i < 1 || i > L->length) {
-        printf("Invalid deletion position\n");
-        return FALSE;
+        ListLog(LIST_ERR_POSITION, "Invalid deletion position %d", i);
+        return LIST_ERR_POSITION;
     }
-    ElemType* q = &(L->elem[i - 1]);
-    ElemType* p = &(L->elem[L->length - 1]);
-    for (++q; q <= p; ++q) {
-        *(q - 1) = *q;
+    if (i == L->length) {
+        IndexRemoveLast(L, L->elem[i - 1], i - 1);
+    }
+    else {
+        IndexInvalidate(L);
     }
+    ElemType* q = &(L->elem[i - 1]);
+    memmove(q, q + 1, (size_t)(L->length - i) * sizeof(ElemType));
     L->length--;
-    // Check if shrinkage is needed
-    if (L->listsize - LISTDECREMENT >= LIST_INIT_SIZE && L->length <= L->listsize - LISTINCREMENT) {
-        if (ShrinkList(L) == FALSE) {
-            printf("Failed to shrink the list during deletion\n");
-            return FALSE;
+    // Release memory once the list is mostly empty
+    ShrinkList(L);
+    return LIST_OK;
+}
+
+/**
+ * @brief Makes room for at least 'needed' elements with a single reallocation.
+ *
+ * Grows to the larger of 'needed' and the next geometric capacity, so that
+ * repeated batch inserts keep the amortized O(1) cost per element.
+ *
+ * @param L Pointer to the list.
+ * @param needed The number of elements the list must be able to hold.
+ * @return LIST_OK if the capacity suffices, LIST_ERR_NOMEM otherwise.
+ */
+int ListEnsureCapacity(SqList* L, int needed) {
+    if (needed <= L->listsize) {
+        return LIST_OK;
+    }
+    int grown = ListGrowCapacity(L->listsize);
+    return ReserveList(L, grown > needed ? grown : needed);
+}
+
+/**
+ * @brief Inserts an array of elements at the specified position in the list.
+ *
+ * The tail is shifted once by 'k' places and the new elements are copied in,
+ * so the cost is O(n + k) with at most one reallocation, instead of 'k'
+ * separate ListInsert calls each shifting the whole tail.
+ *
+ * @param L Pointer to the list.
+ * @param i The position (1-based index) at which the first new element will be placed.
+ * @param src The elements to insert; must not point into the list itself.
+ * @param k The number of elements to insert.
+ * @return LIST_OK on success, LIST_ERR_POSITION if 'i' is out of range,
+ *         LIST_ERR_FULL if 'k' is negative or would overflow the length,
+ *         LIST_ERR_NOMEM if the list could not grow.
+ */
+int ListInsertRange(SqList* L, int i, const ElemType* src, int k) {
+    if (i < 1 || i > L->length + 1) {
+        ListLog(LIST_ERR_POSITION, "Invalid insertion position %d", i);
+        return LIST_ERR_POSITION;
+    }
+    if (k < 0 || k > INT_MAX - L->length) {
+        ListLog(LIST_ERR_FULL, "Invalid insertion count %d", k);
+        return LIST_ERR_FULL;
+    }
+    if (k == 0) {
+        return LIST_OK;
+    }
+    int status = ListEnsureCapacity(L, L->length + k);
+    if (status != LIST_OK) {
+        return status;
+    }
+    ElemType* q = &(L->elem[i - 1]);
+    memmove(q + k, q, (size_t)(L->length - (i - 1)) * sizeof(ElemType));
+    memcpy(q, src, (size_t)k * sizeof(ElemType));
+    L->length += k;
+    if (i == L->length - k + 1) {
+        for (int p = i - 1; p < L->length; p++) {
+            IndexAppend(L, p);
+        }
+    }
+    else {
+        IndexInvalidate(L);
+    }
+    return LIST_OK;
+}
+
+/**
+ * @brief Appends an array of elements to the end of the list.
+ *
+ * @param L Pointer to the list.
+ * @param src The elements to append; must not point into the list itself.
+ * @param k The number of elements to append.
+ * @return LIST_OK on success, otherwise the error from ListInsertRange.
+ */
+int ListAppendRange(SqList* L, const ElemType* src, int k) {
+    return ListInsertRange(L, L->length + 1, src, k);
+}
+
+/**
+ * @brief Deletes the elements at positions [i, j) from the list.
+ *
+ * The tail is moved down once, and ShrinkList is consulted once, so deleting
+ * a block costs O(n) regardless of its size.
+ *
+ * @param L Pointer to the list.
+ * @param i The position (1-based index) of the first element to delete.
+ * @param j The position just past the last element to delete (i <= j <= length + 1).
+ * @return LIST_OK on success, LIST_ERR_POSITION if the range is invalid.
+ */
+int ListDeleteRange(SqList* L, int i, int j) {
+    if (i < 1 || j < i || j > L->length + 1) {
+        ListLog(LIST_ERR_POSITION, "Invalid deletion range [%d, %d)", i, j);
+        return LIST_ERR_POSITION;
+    }
+    if (i == j) {
+        return LIST_OK;
+    }
+    IndexInvalidate(L);
+    memmove(&(L->elem[i - 1]), &(L->elem[j - 1]), (size_t)(L->length - (j - 1)) * sizeof(ElemType));
+    L->length -= j - i;
+    ShrinkList(L);
+    return LIST_OK;
+}
+
+/**
+ * @brief Removes every element for which 'pred' returns nonzero.
+ *
+ * Kept elements are compacted towards the front in a single pass, preserving
+ * their order.
+ *
+ * @param L Pointer to the list.
+ * @param pred Predicate selecting the elements to remove.
+ * @return The number of elements removed.
+ */
+int ListRemoveIf(SqList* L, int (*pred)(ElemType e)) {
+    int kept = 0;
+    for (int i = 0; i < L->length; i++) {
+        ElemType e = L->elem[i];
+        if (!pred(e)) {
+            L->elem[kept++] = e;
+        }
+    }
+    int removed = L->length - kept;
+    L->length = kept;
+    if (removed > 0) {
+        IndexInvalidate(L);
+        ShrinkList(L);
+    }
+    return removed;
+}
+
+/*
+ * Element scan kernels used by LocateElem, PriorElem, NextElem,
+ * ListCountElem and ListFindAll. They assume ElemType is a 32-bit int. On
+ * x86 with GCC or Clang, SSE2 and AVX2 versions compare 16 elements per
+ * step; the widest one the CPU supports is selected on first use. Other
+ * targets use the scalar loops.
+ */
+
+/**
+ * @brief Returns the index of the first element equal to 'e' in a[from, n), or -1.
+ */
+static int FindElemScalar(const ElemType* a, int from, int n, ElemType e) {
+    for (int i = from; i < n; i++) {
+        if (a[i] == e) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Returns the number of elements equal to 'e' in a[0, n).
+ */
+static int CountElemScalar(const ElemType* a, int n, ElemType e) {
+    int count = 0;
+    for (int i = 0; i < n; i++) {
+        count += a[i] == e;
+    }
+    return count;
+}
+
+#ifdef SQLIST_SIMD_X86
+__attribute__((target("sse2")))
+static int FindElemSse2(const ElemType* a, int from, int n, ElemType e) {
+    __m128i key = _mm_set1_epi32(e);
+    int i = from;
+    for (; i + 16 <= n; i += 16) {
+        const __m128i* p = (const __m128i*)(a + i);
+        __m128i c0 = _mm_cmpeq_epi32(_mm_loadu_si128(p), key);
+        __m128i c1 = _mm_cmpeq_epi32(_mm_loadu_si128(p + 1), key);
+        __m128i c2 = _mm_cmpeq_epi32(_mm_loadu_si128(p + 2), key);
+        __m128i c3 = _mm_cmpeq_epi32(_mm_loadu_si128(p + 3), key);
+        __m128i any = _mm_or_si128(_mm_or_si128(c0, c1), _mm_or_si128(c2, c3));
+        if (_mm_movemask_epi8(any) != 0) {
+            unsigned mask = (unsigned)_mm_movemask_ps(_mm_castsi128_ps(c0))
+                | (unsigned)_mm_movemask_ps(_mm_castsi128_ps(c1)) << 4
+                | (unsigned)_mm_movemask_ps(_mm_castsi128_ps(c2)) << 8
+                | (unsigned)_mm_movemask_ps(_mm_castsi128_ps(c3)) << 12;
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return FindElemScalar(a, i, n, e);
+}
+
+__attribute__((target("sse2")))
+static int CountElemSse2(const ElemType* a, int n, ElemType e) {
+    __m128i key = _mm_set1_epi32(e);
+    __m128i acc0 = _mm_setzero_si128();
+    __m128i acc1 = _mm_setzero_si128();
+    int i = 0;
+    // Each match compares to -1, so subtracting the comparison counts it.
+    for (; i + 8 <= n; i += 8) {
+        const __m128i* p = (const __m128i*)(a + i);
+        acc0 = _mm_sub_epi32(acc0, _mm_cmpeq_epi32(_mm_loadu_si128(p), key));
+        acc1 = _mm_sub_epi32(acc1, _mm_cmpeq_epi32(_mm_loadu_si128(p + 1), key));
+    }
+    int lanes[4];
+    _mm_storeu_si128((__m128i*)lanes, _mm_add_epi32(acc0, acc1));
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + CountElemScalar(a + i, n - i, e);
+}
+
+__attribute__((target("avx2")))
+static int FindElemAvx2(const ElemType* a, int from, int n, ElemType e) {
+    __m256i key = _mm256_set1_epi32(e);
+    int i = from;
+    for (; i + 16 <= n; i += 16) {
+        const __m256i* p = (const __m256i*)(a + i);
+        __m256i c0 = _mm256_cmpeq_epi32(_mm256_loadu_si256(p), key);
+        __m256i c1 = _mm256_cmpeq_epi32(_mm256_loadu_si256(p + 1), key);
+        if (!_mm256_testz_si256(_mm256_or_si256(c0, c1), _mm256_or_si256(c0, c1))) {
+            unsigned mask = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(c0))
+                | (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(c1)) << 8;
+            return i + __builtin_ctz(mask);
         }
     }
-    return TRUE;
+    return FindElemScalar(a, i, n, e);
+}
+
+__attribute__((target("avx2")))
+static int CountElemAvx2(const ElemType* a, int n, ElemType e) {
+    __m256i key = _mm256_set1_epi32(e);
+    __m256i acc0 = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m256i* p = (const __m256i*)(a + i);
+        acc0 = _mm256_sub_epi32(acc0, _mm256_cmpeq_epi32(_mm256_loadu_si256(p), key));
+        acc1 = _mm256_sub_epi32(acc1, _mm256_cmpeq_epi32(_mm256_loadu_si256(p + 1), key));
+    }
+    int lanes[8];
+    _mm256_storeu_si256((__m256i*)lanes, _mm256_add_epi32(acc0, acc1));
+    int count = 0;
+    for (int k = 0; k < 8; k++) {
+        count += lanes[k];
+    }
+    return count + CountElemScalar(a + i, n - i, e);
+}
+#endif
+
+typedef int (*FindElemFunc)(const ElemType* a, int from, int n, ElemType e);
+typedef int (*CountElemFunc)(const ElemType* a, int n, ElemType e);
+
+static int FindElemResolve(const ElemType* a, int from, int n, ElemType e);
+static int CountElemResolve(const ElemType* a, int n, ElemType e);
+
+static _Atomic(FindElemFunc) findElem = FindElemResolve; ///< Scan kernel in use; replaced by the best one on first call
+static _Atomic(CountElemFunc) countElem = CountElemResolve; ///< Count kernel in use; replaced by the best one on first call
+
+/**
+ * @brief Picks the widest scan kernels supported by the running CPU.
+ *
+ * Threads that race through here all store the same pointers. The pointers
+ * are atomic so that these stores and the loads in RunFindElem/RunCountElem
+ * are not a data race; relaxed ordering suffices because a pointer to code
+ * publishes no other data.
+ */
+static void SelectScanKernels(void) {
+    FindElemFunc find = FindElemScalar;
+    CountElemFunc count = CountElemScalar;
+#ifdef SQLIST_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        find = FindElemAvx2;
+        count = CountElemAvx2;
+    }
+    else if (__builtin_cpu_supports("sse2")) {
+        find = FindElemSse2;
+        count = CountElemSse2;
+    }
+#endif
+    atomic_store_explicit(&findElem, find, memory_order_relaxed);
+    atomic_store_explicit(&countElem, count, memory_order_relaxed);
+}
+
+/**
+ * @brief Calls the selected scan kernel.
+ */
+static inline int RunFindElem(const ElemType* a, int from, int n, ElemType e) {
+    return atomic_load_explicit(&findElem, memory_order_relaxed)(a, from, n, e);
+}
+
+/**
+ * @brief Calls the selected count kernel.
+ */
+static inline int RunCountElem(const ElemType* a, int n, ElemType e) {
+    return atomic_load_explicit(&countElem, memory_order_relaxed)(a, n, e);
+}
+
+static int FindElemResolve(const ElemType* a, int from, int n, ElemType e) {
+    SelectScanKernels();
+    return RunFindElem(a, from, n, e);
+}
+
+static int CountElemResolve(const ElemType* a, int n, ElemType e) {
+    SelectScanKernels();
+    return RunCountElem(a, n, e);
+}
+
+/**
+ * @brief Returns the 0-based position of the first element equal to 'e', or -1.
+ *
+ * Uses the hash index when the list has one, otherwise the scan kernel.
+ */
+static int FirstPosition(SqList* L, ElemType e) {
+    int i = IndexLookup(L, e);
+    if (i == -2) {
+        i = RunFindElem(L->elem, 0, L->length, e);
+    }
+    return i;
 }
 
 /**
@@ -179,21 +993,21 @@ int ListDelete(SqList* L, int i) {
  * @param L Pointer to the list.
  * @param e The element whose predecessor is to be found.
  * @param result Pointer to store the predecessor element, if found.
- * @return TRUE if the predecessor exists, FALSE if the element is not found or has no predecessor.
+ * @return LIST_OK if the predecessor exists, LIST_ERR_NOT_FOUND if the element
+ *         is not in the list, LIST_ERR_NO_PRIOR if it is the first element.
  */
 int PriorElem(SqList* L, ElemType e, ElemType* result) {
-    for (int i = 0; i < L->length; i++) {
-        if (L->elem[i] == e) {
-            if (i == 0) {
-                printf("No predecessor exists for this element\n");
-                return FALSE;
-            }
-            *result = L->elem[i - 1];
-            return TRUE;
-        }
+    int i = FirstPosition(L, e);
+    if (i < 0) {
+        ListLog(LIST_ERR_NOT_FOUND, "Element not found");
+        return LIST_ERR_NOT_FOUND;
+    }
+    if (i == 0) {
+        ListLog(LIST_ERR_NO_PRIOR, "No predecessor exists for this element");
+        return LIST_ERR_NO_PRIOR;
     }
-    printf("Element not found\n");
-    return FALSE;
+    *result = L->elem[i - 1];
+    return LIST_OK;
 }
 
 /**
@@ -205,38 +1019,78 @@ int PriorElem(SqList* L, ElemType e, ElemType* result) {
  * @param L Pointer to the list.
  * @param e The element whose successor is to be found.
  * @param result Pointer to store the successor element, if found.
- * @return TRUE if the successor exists, FALSE if the element is not found or has no successor.
+ * @return LIST_OK if the successor exists, LIST_ERR_NOT_FOUND if the element
+ *         is not in the list, LIST_ERR_NO_NEXT if it is the last element.
  */
 int NextElem(SqList* L, ElemType e, ElemType* result) {
-    for (int i = 0; i < L->length; i++) {
-        if (L->elem[i] == e) {
-            if (i == L->length - 1) {
-                printf("No successor exists for this element\n");
-                return FALSE;
-            }
-            *result = L->elem[i + 1];
-            return TRUE;
-        }
+    int i = FirstPosition(L, e);
+    if (i < 0) {
+        ListLog(LIST_ERR_NOT_FOUND, "Element not found");
+        return LIST_ERR_NOT_FOUND;
+    }
+    if (i == L->length - 1) {
+        ListLog(LIST_ERR_NO_NEXT, "No successor exists for this element");
+        return LIST_ERR_NO_NEXT;
     }
-    printf("Element not found\n");
-    return FALSE;
+    *result = L->elem[i + 1];
+    return LIST_OK;
 }
 
 /**
  * @brief Locates an element in the list and returns its position.
  *
+ * Takes O(1) through the hash index if ListEnableIndex was called, otherwise
+ * scans with the vectorized kernel selected for this CPU.
+ *
  * @param L Pointer to the list.
  * @param e The element to locate.
- * @return The position (1-based index) of the element, or FALSE if not found.
+ * @return The position (1-based index) of the element, or 0 if not found.
  */
 int LocateElem(SqList* L, ElemType e) {
-    for (int i = 0; i < L->length; i++) {
-        if (L->elem[i] == e) {
-            return i + 1;
+    int i = FirstPosition(L, e);
+    if (i < 0) {
+        ListLog(LIST_ERR_NOT_FOUND, "Element not found");
+        return 0;
+    }
+    return i + 1;
+}
+
+/**
+ * @brief Counts the elements equal to 'e'.
+ *
+ * @param L Pointer to the list.
+ * @param e The element to count.
+ * @return The number of occurrences of 'e' in the list.
+ */
+int ListCountElem(SqList* L, ElemType e) {
+    return RunCountElem(L->elem, L->length, e);
+}
+
+/**
+ * @brief Finds every position holding an element equal to 'e'.
+ *
+ * Positions are written in increasing order. The return value is the total
+ * number of matches, which can exceed 'max'; only the first 'max' positions
+ * are stored, so a caller may size 'positions' with ListCountElem first or
+ * call again with a larger buffer.
+ *
+ * @param L Pointer to the list.
+ * @param e The element to find.
+ * @param positions Output array receiving 1-based positions (may be NULL if 'max' is 0).
+ * @param max The capacity of 'positions'.
+ * @return The number of elements equal to 'e'.
+ */
+int ListFindAll(SqList* L, ElemType e, int* positions, int max) {
+    int found = 0;
+    int i = RunFindElem(L->elem, 0, L->length, e);
+    while (i >= 0) {
+        if (found < max) {
+            positions[found] = i + 1;
         }
+        found++;
+        i = RunFindElem(L->elem, i + 1, L->length, e);
     }
-    printf("Element not found\n");
-    return FALSE;
+    return found;
 }
 
 /**
@@ -248,7 +1102,8 @@ int LocateElem(SqList* L, ElemType e) {
  */
 void ClearList(SqList* L) {
     L->length = 0;
-    printf("List cleared\n");
+    IndexInvalidate(L);
+    ListLog(LIST_OK, "List cleared");
 }
 
 /**
@@ -259,12 +1114,13 @@ void ClearList(SqList* L) {
  * @param L Pointer to the list to be destroyed.
  */
 void DestroyList(SqList* L) {
+    ListDisableIndex(L);
     if (L->elem != NULL) {
-        free(L->elem);
+        ElemRelease(L);
         L->elem = NULL;
         L->length = 0;
         L->listsize = 0;
-        printf("List destroyed\n");
+        ListLog(LIST_OK, "List destroyed");
     }
 }
 
@@ -280,30 +1136,103 @@ void Swap(ElemType* a, ElemType* b) {
     *b = temp;
 }
 
+/**
+ * @brief Moves the elements of a[0, n) satisfying 'pred' to the front, in any order.
+ *
+ * Branchless Lomuto partition: every element is swapped with the first
+ * element of the "false" block, and the predicate result (0 or 1) only
+ * decides whether that block's start advances. The loop body has no
+ * data-dependent branch, so random input costs no mispredictions. Marked
+ * static inline so that callers passing a constant predicate, such as
+ * ChangeNums, get it inlined into the loop.
+ *
+ * @param a Array to partition.
+ * @param n Number of elements.
+ * @param pred Predicate selecting the elements that go first.
+ * @return The number of elements satisfying 'pred'.
+ */
+static inline int PartitionKernel(ElemType* a, int n, int (*pred)(ElemType e)) {
+    int w = 0;
+    for (int i = 0; i < n; i++) {
+        ElemType x = a[i];
+        int t = pred(x) != 0;
+        a[i] = a[w];
+        a[w] = x;
+        w += t;
+    }
+    return w;
+}
+
+/**
+ * @brief Reorders the list so that the elements satisfying 'pred' come first.
+ *
+ * The relative order within each group is not preserved. Runs in linear
+ * time without data-dependent branches (see PartitionKernel).
+ *
+ * @param L Pointer to the list.
+ * @param pred Predicate selecting the elements that go first.
+ * @return The number of elements satisfying 'pred'; they occupy positions 1 to the returned count.
+ */
+int ListPartition(SqList* L, int (*pred)(ElemType e)) {
+    IndexInvalidate(L);
+    return PartitionKernel(L->elem, L->length, pred);
+}
+
+/**
+ * @brief Reorders the list so that the elements satisfying 'pred' come first, keeping their order.
+ *
+ * Elements that satisfy 'pred' are compacted in place, the others are
+ * collected in a temporary buffer and copied back behind them. Both writes
+ * happen for every element, with the predicate only selecting which
+ * cursor advances, so this pass is branch-free as well.
+ *
+ * @param L Pointer to the list.
+ * @param pred Predicate selecting the elements that go first.
+ * @return The number of elements satisfying 'pred', or LIST_ERR_NOMEM if the
+ *         temporary buffer could not be allocated (the list is unchanged).
+ */
+int ListStablePartition(SqList* L, int (*pred)(ElemType e)) {
+    int n = L->length;
+    ElemType* rest = (ElemType*)malloc((size_t)(n > 0 ? n : 1) * sizeof(ElemType));
+    if (!rest) {
+        ListLog(LIST_ERR_NOMEM, "Partition buffer allocation failed");
+        return LIST_ERR_NOMEM;
+    }
+    ElemType* a = L->elem;
+    int w = 0;
+    int r = 0;
+    for (int i = 0; i < n; i++) {
+        ElemType x = a[i];
+        int t = pred(x) != 0;
+        a[w] = x;
+        rest[r] = x;
+        w += t;
+        r += 1 - t;
+    }
+    memcpy(a + w, rest, (size_t)r * sizeof(ElemType));
+    free(rest);
+    IndexInvalidate(L);
+    return w;
+}
+
+/**
+ * @brief Returns nonzero if 'e' is odd.
+ */
+static int IsOdd(ElemType e) {
+    return e & 1;
+}
+
 /**
  * @brief Reorders the list such that odd numbers precede even numbers.
  *
- * Partitions the list into two parts, with all odd elements appearing before all even elements.
+ * Partitions the list into two parts, with all odd elements appearing before
+ * all even elements, using the branchless partition of ListPartition.
  *
  * @param L Pointer to the list.
  */
 void ChangeNums(SqList* L) {
-    int left = 0;
-    int right = L->length - 1;
-    while (left < right) {
-        // Move left pointer to the right until an even number is found
-        while (left < right && L->elem[left] % 2 != 0) {
-            left++;
-        }
-        // Move right pointer to the left until an odd number is found
-        while (left < right && L->elem[right] % 2 == 0) {
-            right--;
-        }
-        // Swap the odd and even numbers
-        if (left < right) {
-            Swap(&L->elem[left], &L->elem[right]);
-        }
-    }
+    IndexInvalidate(L);
+    PartitionKernel(L->elem, L->length, IsOdd);
 }
 
 /**
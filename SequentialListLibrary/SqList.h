@@ -1,12 +1,40 @@
 #ifndef Xperance_SQLIST
 #define Xperance_SQLIST
 
+#include "ListAllocator.h"
+
 #define LIST_INIT_SIZE 80 ///< The initial size allocated for the list
 #define LISTINCREMENT 10 ///< The size increment used when expanding the list
-#define LISTDECREMENT 10 ///< The size decrement used when shrinking the list
+#define LISTDECREMENT 10 ///< Former fixed shrink step; ShrinkList now uses LIST_SHRINK_THRESHOLD/LIST_SHRINK_FACTOR
+#define LIST_SHRINK_THRESHOLD 4 ///< The list shrinks only when less than 1/LIST_SHRINK_THRESHOLD of it is in use
+#define LIST_SHRINK_FACTOR 2 ///< The capacity is divided by this factor when the list shrinks
+#ifndef LIST_GROWTH_FACTOR
+#define LIST_GROWTH_FACTOR 1.5 ///< Capacity multiplier used when expanding the list (override with -D)
+#endif
 #define TRUE 1 ///< Boolean value for true
 #define FALSE 0 ///< Boolean value for false
 
+/*
+ * Status codes. Functions that used to return TRUE/FALSE now return
+ * LIST_OK on success and a negative LIST_ERR_* code on failure. This
+ * breaks callers that detect failure with '== FALSE' or '!': failures
+ * are no longer 0, so those checks never fire. Test '!= LIST_OK' (or
+ * '< 0' for errors only) instead. Checks for success with '== TRUE' keep
+ * working, since LIST_OK equals TRUE. JudgmentList and SortedCheck are
+ * predicates and still return TRUE/FALSE.
+ */
+#define LIST_OK 1 ///< Operation succeeded (equal to TRUE)
+#define LIST_UNCHANGED 0 ///< Nothing to do, e.g. ShrinkList found no excess capacity
+#define LIST_ERR_POSITION (-1) ///< Position or range is outside the list
+#define LIST_ERR_NOMEM (-2) ///< Memory allocation failed; the list is left unchanged
+#define LIST_ERR_FULL (-3) ///< The length or capacity would exceed INT_MAX
+#define LIST_ERR_NOT_FOUND (-4) ///< The requested element is not in the list
+#define LIST_ERR_NO_PRIOR (-5) ///< The element is the first one and has no predecessor
+#define LIST_ERR_NO_NEXT (-6) ///< The element is the last one and has no successor
+#define LIST_ERR_IO (-7) ///< A file operation failed (file-backed lists)
+#define LIST_ERR_FORMAT (-8) ///< The file is not a list file of this element type and version
+#define LIST_ERR_CHECKSUM (-9) ///< The stored elements do not match the file's checksum
+
 typedef int ElemType; ///< Type definition for elements stored in the sequential list
 
 /**
@@ -15,13 +43,44 @@ typedef int ElemType; ///< Type definition for elements stored in the sequential
  * @elem Pointer to the dynamic array holding the list elements.
  * @length Current number of elements in the list.
  * @listsize Current allocated size of the list.
+ * @index Optional hash index used by the value lookups.
+ * @allocator Allocation hooks for the element array, NULL for the C library.
  */
+struct ListIndex; ///< Hash index from value to position, see ListEnableIndex
+
 typedef struct {
     ElemType* elem; ///< Pointer to the element array
     int length; ///< Current number of elements in the list
     int listsize; ///< Current allocated capacity of the list
+    struct ListIndex* index; ///< Optional value index, NULL unless ListEnableIndex was called
+    const ListAllocator* allocator; ///< Storage hooks for 'elem', NULL for malloc/realloc/free
 } SqList;
 
+/**
+ * @brief Callback receiving diagnostic messages from the list functions.
+ *
+ * @param status The status code the message relates to (LIST_OK for informational messages).
+ * @param message The formatted message, without a trailing newline.
+ */
+typedef void (*ListLogHook)(int status, const char* message);
+
+/**
+ * @brief Installs a process-wide callback for diagnostic messages.
+ *
+ * No hook is installed by default, so the list functions do no I/O.
+ *
+ * @param hook The callback to install, or NULL to disable diagnostics.
+ */
+void SetListLogHook(ListLogHook hook);
+
+/**
+ * @brief Returns a short human-readable description of a status code.
+ *
+ * @param status A LIST_OK, LIST_UNCHANGED or LIST_ERR_* value.
+ * @return A static string describing the status.
+ */
+const char* ListStatusString(int status);
+
 /**
  * @brief Initializes a new sequential list.
  *
@@ -31,6 +90,28 @@ typedef struct {
  */
 void InitList(SqList* L);
 
+/**
+ * @brief Initializes a new sequential list with room for at least 'capacity' elements.
+ *
+ * @param L Pointer to the list to be initialized.
+ * @param capacity The number of elements to allocate up front (LIST_INIT_SIZE if less than 1).
+ * @return LIST_OK on success, LIST_ERR_NOMEM if the allocation failed.
+ */
+int InitListWithCapacity(SqList* L, int capacity);
+
+/**
+ * @brief Initializes a new sequential list whose elements are stored through 'allocator'.
+ *
+ * The allocator (for example &arena.allocator of a ListArena) must outlive
+ * the list.
+ *
+ * @param L Pointer to the list to be initialized.
+ * @param capacity The number of elements to allocate up front (LIST_INIT_SIZE if less than 1).
+ * @param allocator The allocation hooks, or NULL for malloc/realloc/free.
+ * @return LIST_OK on success, LIST_ERR_NOMEM if the allocation failed.
+ */
+int InitListWithAllocator(SqList* L, int capacity, const ListAllocator* allocator);
+
 /**
  * @brief Checks if the sequential list is empty.
  *
@@ -56,53 +137,163 @@ int LengthList(SqList* L);
  * @param L Pointer to the list.
  * @param i The position (1-based index) of the element to retrieve.
  * @param result Pointer to store the element if found.
- * @return TRUE if the element exists at the specified position, FALSE if the position is invalid.
+ * @return LIST_OK if the element exists at the specified position, LIST_ERR_POSITION if the position is invalid.
  */
 int OrderNum(SqList* L, int i, ElemType* result);
 
 /**
- * @brief Expands the size of the list by a defined increment.
+ * @brief Expands the capacity of the list geometrically.
  *
- * Allocates additional memory to the list to allow for more elements.
+ * Multiplies the capacity by LIST_GROWTH_FACTOR (growing by at least
+ * LISTINCREMENT), so a sequence of appends costs amortized O(1) each.
  *
  * @param L Pointer to the list.
- * @return TRUE if expansion is successful, otherwise FALSE.
+ * @return LIST_OK on success, LIST_ERR_FULL if the capacity is already INT_MAX,
+ *         LIST_ERR_NOMEM if the reallocation failed.
  */
 int ExpandList(SqList* L);
 
 /**
- * @brief Shrinks the size of the list by a defined decrement if necessary.
+ * @brief Computes the capacity to grow to from the current one.
  *
- * Releases excess memory if the list's capacity is much larger than its length.
+ * Grows by LIST_GROWTH_FACTOR but at least by LISTINCREMENT, and never past
+ * INT_MAX. This is the growth policy of every list in the library.
+ *
+ * @param listsize The current capacity.
+ * @return The new capacity, or 'listsize' if the list cannot grow any further.
+ */
+int ListGrowCapacity(int listsize);
+
+/**
+ * @brief Computes the capacity to shrink to for 'length' elements.
+ *
+ * Once fewer than 1/LIST_SHRINK_THRESHOLD of the capacity is used, divides
+ * it by LIST_SHRINK_FACTOR as often as that still holds, never below
+ * LIST_INIT_SIZE. This is the shrink policy of every list in the library.
+ *
+ * @param length The number of elements in use.
+ * @param listsize The current capacity.
+ * @return The new capacity, or 'listsize' if no shrink is due.
+ */
+int ListShrinkCapacity(int length, int listsize);
+
+/**
+ * @brief Makes room for at least 'needed' elements with a single reallocation.
+ *
+ * Grows to the larger of 'needed' and ListGrowCapacity, so that repeated
+ * batch inserts keep the amortized O(1) cost per element.
  *
  * @param L Pointer to the list.
- * @return TRUE if shrinkage is successful, otherwise FALSE.
+ * @param needed The number of elements the list must be able to hold.
+ * @return LIST_OK if the capacity suffices, LIST_ERR_NOMEM otherwise.
+ */
+int ListEnsureCapacity(SqList* L, int needed);
+
+/**
+ * @brief Ensures the list can hold at least 'capacity' elements without reallocating.
+ *
+ * @param L Pointer to the list.
+ * @param capacity The minimum capacity required.
+ * @return LIST_OK if the capacity is now at least 'capacity', LIST_ERR_NOMEM otherwise.
+ */
+int ReserveList(SqList* L, int capacity);
+
+/**
+ * @brief Shrinks the capacity of the list if it is mostly empty.
+ *
+ * Once fewer than 1/LIST_SHRINK_THRESHOLD of the capacity is used, divides
+ * it by LIST_SHRINK_FACTOR as often as that still holds (down to
+ * LIST_INIT_SIZE at most) and reallocates once, leaving room for hysteresis.
+ *
+ * @param L Pointer to the list.
+ * @return LIST_OK if the capacity was reduced, LIST_UNCHANGED if no shrink was due,
+ *         LIST_ERR_NOMEM if the reallocation failed.
  */
 int ShrinkList(SqList* L);
 
+/**
+ * @brief Reduces the capacity of the list to its current length.
+ *
+ * @param L Pointer to the list.
+ * @return LIST_OK if the capacity now matches the length, LIST_ERR_NOMEM otherwise.
+ */
+int ShrinkToFit(SqList* L);
+
 /**
  * @brief Inserts an element at the specified position in the list.
  *
- * Shifts subsequent elements to the right to make space for the new element.
+ * Shifts subsequent elements to the right (with a single memmove) to make space for the new element.
  *
  * @param L Pointer to the list.
  * @param i The position (1-based index) at which to insert the element.
  * @param e The element to be inserted.
- * @return TRUE if insertion is successful, otherwise FALSE.
+ * @return LIST_OK on success, LIST_ERR_POSITION if 'i' is out of range, or
+ *         the error from ExpandList if the list could not grow.
  */
 int ListInsert(SqList* L, int i, ElemType e);
 
+/**
+ * @brief Appends an element to the end of the list in amortized O(1) time.
+ *
+ * @param L Pointer to the list.
+ * @param e The element to be appended.
+ * @return LIST_OK on success, or the error from ExpandList if the list could not grow.
+ */
+int ListAppend(SqList* L, ElemType e);
+
 /**
  * @brief Deletes the element at the specified position in the list.
  *
- * Shifts subsequent elements to the left to fill the gap left by the deleted element.
+ * Shifts subsequent elements to the left (with a single memmove) to fill the gap left by the deleted element.
  *
  * @param L Pointer to the list.
  * @param i The position (1-based index) of the element to delete.
- * @return TRUE if deletion is successful, otherwise FALSE.
+ * @return LIST_OK on success, LIST_ERR_POSITION if 'i' is out of range.
  */
 int ListDelete(SqList* L, int i);
 
+/**
+ * @brief Inserts an array of elements at the specified position in O(n + k).
+ *
+ * @param L Pointer to the list.
+ * @param i The position (1-based index) at which the first new element will be placed.
+ * @param src The elements to insert; must not point into the list itself.
+ * @param k The number of elements to insert.
+ * @return LIST_OK on success, LIST_ERR_POSITION if 'i' is out of range,
+ *         LIST_ERR_FULL if 'k' is negative or would overflow the length,
+ *         LIST_ERR_NOMEM if the list could not grow.
+ */
+int ListInsertRange(SqList* L, int i, const ElemType* src, int k);
+
+/**
+ * @brief Appends an array of elements to the end of the list.
+ *
+ * @param L Pointer to the list.
+ * @param src The elements to append; must not point into the list itself.
+ * @param k The number of elements to append.
+ * @return LIST_OK on success, otherwise the error from ListInsertRange.
+ */
+int ListAppendRange(SqList* L, const ElemType* src, int k);
+
+/**
+ * @brief Deletes the elements at positions [i, j) from the list in O(n).
+ *
+ * @param L Pointer to the list.
+ * @param i The position (1-based index) of the first element to delete.
+ * @param j The position just past the last element to delete.
+ * @return LIST_OK on success, LIST_ERR_POSITION if the range is invalid.
+ */
+int ListDeleteRange(SqList* L, int i, int j);
+
+/**
+ * @brief Removes every element for which 'pred' returns nonzero, in one pass.
+ *
+ * @param L Pointer to the list.
+ * @param pred Predicate selecting the elements to remove.
+ * @return The number of elements removed.
+ */
+int ListRemoveIf(SqList* L, int (*pred)(ElemType e));
+
 /**
  * @brief Returns the predecessor of the specified element in the list.
  *
@@ -112,7 +303,8 @@ int ListDelete(SqList* L, int i);
  * @param L Pointer to the list.
  * @param e The element whose predecessor is to be found.
  * @param result Pointer to store the predecessor element, if found.
- * @return TRUE if the predecessor exists, FALSE if the element is not found or has no predecessor.
+ * @return LIST_OK if the predecessor exists, LIST_ERR_NOT_FOUND if the element
+ *         is not in the list, LIST_ERR_NO_PRIOR if it is the first element.
  */
 int PriorElem(SqList* L, ElemType e, ElemType* result);
 
@@ -125,19 +317,69 @@ int PriorElem(SqList* L, ElemType e, ElemType* result);
  * @param L Pointer to the list.
  * @param e The element whose successor is to be found.
  * @param result Pointer to store the successor element, if found.
- * @return TRUE if the successor exists, FALSE if the element is not found or has no successor.
+ * @return LIST_OK if the successor exists, LIST_ERR_NOT_FOUND if the element
+ *         is not in the list, LIST_ERR_NO_NEXT if it is the last element.
  */
-int GetNextElem(SqList* L, ElemType e, ElemType* result);
+int NextElem(SqList* L, ElemType e, ElemType* result);
 
 /**
  * @brief Locates an element in the list and returns its position.
  *
  * @param L Pointer to the list.
  * @param e The element to locate.
- * @return The position (1-based index) of the element, or FALSE if not found.
+ * @return The position (1-based index) of the element, or 0 if not found.
  */
 int LocateElem(SqList* L, ElemType e);
 
+/**
+ * @brief Counts the elements equal to 'e'.
+ *
+ * @param L Pointer to the list.
+ * @param e The element to count.
+ * @return The number of occurrences of 'e' in the list.
+ */
+int ListCountElem(SqList* L, ElemType e);
+
+/**
+ * @brief Finds every position holding an element equal to 'e'.
+ *
+ * Stores at most 'max' 1-based positions in increasing order.
+ *
+ * @param L Pointer to the list.
+ * @param e The element to find.
+ * @param positions Output array receiving the positions (may be NULL if 'max' is 0).
+ * @param max The capacity of 'positions'.
+ * @return The total number of matches, which may exceed 'max'.
+ */
+int ListFindAll(SqList* L, ElemType e, int* positions, int max);
+
+/**
+ * @brief Attaches a hash index to the list for O(1) value lookups.
+ *
+ * LocateElem, PriorElem and NextElem then use the index instead of scanning.
+ * Appends and deletions of the last element update it in place; other edits
+ * make the next lookup rebuild it in O(n). Code that writes to L->elem
+ * directly must call ListInvalidateIndex afterwards.
+ *
+ * @param L Pointer to the list.
+ * @return LIST_OK on success (or if an index already exists), LIST_ERR_NOMEM otherwise.
+ */
+int ListEnableIndex(SqList* L);
+
+/**
+ * @brief Detaches and frees the hash index of the list, if any.
+ *
+ * @param L Pointer to the list.
+ */
+void ListDisableIndex(SqList* L);
+
+/**
+ * @brief Tells the index that the elements were modified outside the list functions.
+ *
+ * @param L Pointer to the list.
+ */
+void ListInvalidateIndex(SqList* L);
+
 /**
  * @brief Clears all elements from the list.
  *
@@ -164,10 +406,32 @@ void DestroyList(SqList* L);
  */
 void Swap(ElemType* a, ElemType* b);
 
+/**
+ * @brief Reorders the list so that the elements satisfying 'pred' come first.
+ *
+ * Branch-free single pass; the order within each group is not preserved.
+ *
+ * @param L Pointer to the list.
+ * @param pred Predicate selecting the elements that go first.
+ * @return The number of elements satisfying 'pred'.
+ */
+int ListPartition(SqList* L, int (*pred)(ElemType e));
+
+/**
+ * @brief Reorders the list so that the elements satisfying 'pred' come first, keeping their order.
+ *
+ * @param L Pointer to the list.
+ * @param pred Predicate selecting the elements that go first.
+ * @return The number of elements satisfying 'pred', or LIST_ERR_NOMEM if the
+ *         temporary buffer could not be allocated.
+ */
+int ListStablePartition(SqList* L, int (*pred)(ElemType e));
+
 /**
  * @brief Reorders the list such that odd numbers precede even numbers.
  *
  * Partitions the list into two parts, with all odd elements appearing before all even elements.
+ * Built on the branchless kernel of ListPartition, so the order within each part is unspecified.
  *
  * @param L Pointer to the list.
  */
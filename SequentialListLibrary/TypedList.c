@@ -0,0 +1,9 @@
+#include "TypedList.h"
+
+/*
+ * Instantiations of DEFINE_TYPED_LIST for the built-in element types. Lists
+ * of other types are instantiated the same way where they are needed.
+ */
+
+DEFINE_TYPED_LIST(, SqListInt64, int64_t, TYPED_LIST_EQUAL)
+DEFINE_TYPED_LIST(, SqListDouble, double, TYPED_LIST_EQUAL)
@@ -0,0 +1,318 @@
+#ifndef XPERANCE_TYPEDLIST
+#define XPERANCE_TYPEDLIST
+
+#include "SqList.h"
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Sequential lists for element types other than ElemType.
+ *
+ * SqList stores ints. The macros below generate the same list for any type
+ * that can be copied by assignment: elements stay contiguous and unboxed,
+ * and every loop compares and moves values of the concrete type, so each
+ * instantiation is compiled (and vectorized) as if it had been written by
+ * hand. Positions are 1-based and the functions return the status codes of
+ * SqList.h, like their SqList counterparts. Capacity follows the same
+ * policy, through ListGrowCapacity and ListShrinkCapacity.
+ */
+
+/**
+ * @brief Default equality test for arithmetic element types.
+ */
+#define TYPED_LIST_EQUAL(a, b) ((a) == (b))
+
+/**
+ * @brief Defines the list structure for one element type.
+ *
+ * @param Name Name of the generated structure type.
+ * @param Type Element type.
+ */
+#define TYPED_LIST_TYPE(Name, Type)                                                     \
+typedef struct {                                                                        \
+    Type* elem; /* Pointer to the element array */                                      \
+    int length; /* Current number of elements in the list */                            \
+    int listsize; /* Current allocated capacity of the list */                          \
+} Name;
+
+/**
+ * @brief Defines the list structure and declares its functions.
+ *
+ * Use in a header, paired with DEFINE_TYPED_LIST with empty scope in one
+ * translation unit. The declared functions are:
+ *     int  NameInit(Name* L, int capacity);
+ *     void NameDestroy(Name* L);
+ *     void NameClear(Name* L);
+ *     int  NameLength(const Name* L);
+ *     int  NameGet(const Name* L, int i, Type* result);
+ *     int  NameReserve(Name* L, int capacity);
+ *     int  NameShrinkToFit(Name* L);
+ *     int  NameInsert(Name* L, int i, Type e);
+ *     int  NameAppend(Name* L, Type e);
+ *     int  NameDelete(Name* L, int i);
+ *     int  NameInsertRange(Name* L, int i, const Type* src, int k);
+ *     int  NameDeleteRange(Name* L, int i, int j);
+ *     int  NameLocate(const Name* L, Type e);
+ *     int  NamePrior(const Name* L, Type e, Type* result);
+ *     int  NameNext(const Name* L, Type e, Type* result);
+ * Each behaves like the SqList function of the same role (InitListWithCapacity,
+ * DestroyList, ClearList, LengthList, OrderNum, ReserveList, ShrinkToFit,
+ * ListInsert, ListAppend, ListDelete, ListInsertRange, ListDeleteRange,
+ * LocateElem, PriorElem, NextElem). As there, a capacity below 1 in NameInit
+ * means LIST_INIT_SIZE.
+ *
+ * @param Name Name of the structure type and prefix of the functions.
+ * @param Type Element type.
+ */
+#define DECLARE_TYPED_LIST(Name, Type)                                                  \
+TYPED_LIST_TYPE(Name, Type)                                                             \
+int Name##Init(Name* L, int capacity);                                                  \
+void Name##Destroy(Name* L);                                                            \
+void Name##Clear(Name* L);                                                              \
+int Name##Length(const Name* L);                                                        \
+int Name##Get(const Name* L, int i, Type* result);                                      \
+int Name##Reserve(Name* L, int capacity);                                               \
+int Name##ShrinkToFit(Name* L);                                                         \
+int Name##Insert(Name* L, int i, Type e);                                               \
+int Name##Append(Name* L, Type e);                                                      \
+int Name##Delete(Name* L, int i);                                                       \
+int Name##InsertRange(Name* L, int i, const Type* src, int k);                          \
+int Name##DeleteRange(Name* L, int i, int j);                                           \
+int Name##Locate(const Name* L, Type e);                                                \
+int Name##Prior(const Name* L, Type e, Type* result);                                   \
+int Name##Next(const Name* L, Type e, Type* result);
+
+/**
+ * @brief Generates the list functions for one element type.
+ *
+ * The structure must already exist (from TYPED_LIST_TYPE or
+ * DECLARE_TYPED_LIST). For a list private to one translation unit, pass
+ * 'static inline' as the scope.
+ *
+ * Example:
+ *     typedef struct { uint64_t key; double value; } Record;
+ *     #define RECORD_EQUAL(a, b) ((a).key == (b).key)
+ *     TYPED_LIST_TYPE(RecordList, Record)
+ *     DEFINE_TYPED_LIST(static inline, RecordList, Record, RECORD_EQUAL)
+ *
+ * @param scope Storage class of the functions (e.g. 'static inline', or empty).
+ * @param Name Name of the structure type and prefix of the functions.
+ * @param Type Element type.
+ * @param Equal Function-like macro or function taking two values and
+ *              returning nonzero if they are equal.
+ */
+#define DEFINE_TYPED_LIST(scope, Name, Type, Equal)                                     \
+static int Name##EnsureCapacity(Name* L, int needed) {                                  \
+    if (needed <= L->listsize) {                                                        \
+        return LIST_OK;                                                                 \
+    }                                                                                   \
+    /* Same geometric growth as ListEnsureCapacity. */                                  \
+    int grown = ListGrowCapacity(L->listsize);                                          \
+    if (grown < needed) {                                                               \
+        grown = needed;                                                                 \
+    }                                                                                   \
+    Type* newbase = (Type*)realloc(L->elem, (size_t)grown * sizeof(Type));              \
+    if (!newbase) {                                                                     \
+        return LIST_ERR_NOMEM;                                                          \
+    }                                                                                   \
+    L->elem = newbase;                                                                  \
+    L->listsize = grown;                                                                \
+    return LIST_OK;                                                                     \
+}                                                                                       \
+                                                                                        \
+static void Name##MaybeShrink(Name* L) {                                                \
+    int newsize = ListShrinkCapacity(L->length, L->listsize);                           \
+    if (newsize == L->listsize) {                                                       \
+        return;                                                                         \
+    }                                                                                   \
+    Type* newbase = (Type*)realloc(L->elem, (size_t)newsize * sizeof(Type));            \
+    if (newbase) {                                                                      \
+        L->elem = newbase;                                                              \
+        L->listsize = newsize;                                                          \
+    }                                                                                   \
+}                                                                                       \
+                                                                                        \
+scope int Name##Init(Name* L, int capacity) {                                           \
+    if (capacity < 1) {                                                                 \
+        capacity = LIST_INIT_SIZE;                                                      \
+    }                                                                                   \
+    L->length = 0;                                                                      \
+    L->elem = (Type*)malloc((size_t)capacity * sizeof(Type));                           \
+    if (!L->elem) {                                                                     \
+        L->listsize = 0;                                                                \
+        return LIST_ERR_NOMEM;                                                          \
+    }                                                                                   \
+    L->listsize = capacity;                                                             \
+    return LIST_OK;                                                                     \
+}                                                                                       \
+                                                                                        \
+scope void Name##Destroy(Name* L) {                                                     \
+    free(L->elem);                                                                      \
+    L->elem = NULL;                                                                     \
+    L->length = 0;                                                                      \
+    L->listsize = 0;                                                                    \
+}                                                                                       \
+                                                                                        \
+scope void Name##Clear(Name* L) {                                                       \
+    L->length = 0;                                                                      \
+}                                                                                       \
+                                                                                        \
+scope int Name##Length(const Name* L) {                                                 \
+    return L->length;                                                                   \
+}                                                                                       \
+                                                                                        \
+scope int Name##Get(const Name* L, int i, Type* result) {                               \
+    if (i < 1 || i > L->length) {                                                       \
+        return LIST_ERR_POSITION;                                                       \
+    }                                                                                   \
+    *result = L->elem[i - 1];                                                           \
+    return LIST_OK;                                                                     \
+}                                                                                       \
+                                                                                        \
+scope int Name##Reserve(Name* L, int capacity) {                                        \
+    if (capacity <= L->listsize) {                                                      \
+        return LIST_OK;                                                                 \
+    }                                                                                   \
+    Type* newbase = (Type*)realloc(L->elem, (size_t)capacity * sizeof(Type));           \
+    if (!newbase) {                                                                     \
+        return LIST_ERR_NOMEM;                                                          \
+    }                                                                                   \
+    L->elem = newbase;                                                                  \
+    L->listsize = capacity;                                                             \
+    return LIST_OK;                                                                     \
+}                                                                                       \
+                                                                                        \
+scope int Name##ShrinkToFit(Name* L) {                                                  \
+    int newsize = L->length > 0 ? L->length : 1;                                        \
+    if (newsize == L->listsize) {                                                       \
+        return LIST_OK;                                                                 \
+    }                                                                                   \
+    Type* newbase = (Type*)realloc(L->elem, (size_t)newsize * sizeof(Type));            \
+    if (!newbase) {                                                                     \
+        return LIST_ERR_NOMEM;                                                          \
+    }                                                                                   \
+    L->elem = newbase;                                                                  \
+    L->listsize = newsize;                                                              \
+    return LIST_OK;                                                                     \
+}                                                                                       \
+                                                                                        \
+scope int Name##InsertRange(Name* L, int i, const Type* src, int k) {                   \
+    if (i < 1 || i > L->length + 1) {                                                   \
+        return LIST_ERR_POSITION;                                                       \
+    }                                                                                   \
+    if (k < 0 || k > INT_MAX - L->length) {                                             \
+        return LIST_ERR_FULL;                                                           \
+    }                                                                                   \
+    if (k == 0) {                                                                       \
+        return LIST_OK;                                                                 \
+    }                                                                                   \
+    int status = Name##EnsureCapacity(L, L->length + k);                                \
+    if (status != LIST_OK) {                                                            \
+        return status;                                                                  \
+    }                                                                                   \
+    Type* q = &(L->elem[i - 1]);                                                        \
+    memmove(q + k, q, (size_t)(L->length - (i - 1)) * sizeof(Type));                    \
+    memcpy(q, src, (size_t)k * sizeof(Type));                                           \
+    L->length += k;                                                                     \
+    return LIST_OK;                                                                     \
+}                                                                                       \
+                                                                                        \
+scope int Name##Insert(Name* L, int i, Type e) {                                        \
+    if (i < 1 || i > L->length + 1) {                                                   \
+        return LIST_ERR_POSITION;                                                       \
+    }                                                                                   \
+    if (L->length >= L->listsize) {                                                     \
+        if (L->length == INT_MAX) {                                                     \
+            return LIST_ERR_FULL;                                                       \
+        }                                                                               \
+        int status = Name##EnsureCapacity(L, L->length + 1);                            \
+        if (status != LIST_OK) {                                                        \
+            return status;                                                              \
+        }                                                                               \
+    }                                                                                   \
+    Type* q = &(L->elem[i - 1]);                                                        \
+    memmove(q + 1, q, (size_t)(L->length - (i - 1)) * sizeof(Type));                    \
+    *q = e;                                                                             \
+    L->length++;                                                                        \
+    return LIST_OK;                                                                     \
+}                                                                                       \
+                                                                                        \
+scope int Name##Append(Name* L, Type e) {                                               \
+    if (L->length >= L->listsize) {                                                     \
+        if (L->length == INT_MAX) {                                                     \
+            return LIST_ERR_FULL;                                                       \
+        }                                                                               \
+        int status = Name##EnsureCapacity(L, L->length + 1);                            \
+        if (status != LIST_OK) {                                                        \
+            return status;                                                              \
+        }                                                                               \
+    }                                                                                   \
+    L->elem[L->length++] = e;                                                           \
+    return LIST_OK;                                                                     \
+}                                                                                       \
+                                                                                        \
+scope int Name##DeleteRange(Name* L, int i, int j) {                                    \
+    if (i < 1 || j < i || j > L->length + 1) {                                          \
+        return LIST_ERR_POSITION;                                                       \
+    }                                                                                   \
+    if (i == j) {                                                                       \
+        return LIST_OK;                                                                 \
+    }                                                                                   \
+    memmove(&(L->elem[i - 1]), &(L->elem[j - 1]), (size_t)(L->length - (j - 1)) * sizeof(Type));\
+    L->length -= j - i;                                                                 \
+    Name##MaybeShrink(L);                                                               \
+    return LIST_OK;                                                                     \
+}                                                                                       \
+                                                                                        \
+scope int Name##Delete(Name* L, int i) {                                                \
+    return Name##DeleteRange(L, i, i + 1);                                              \
+}                                                                                       \
+                                                                                        \
+scope int Name##Locate(const Name* L, Type e) {                                         \
+    for (int i = 0; i < L->length; i++) {                                               \
+        if (Equal(L->elem[i], e)) {                                                     \
+            return i + 1;                                                               \
+        }                                                                               \
+    }                                                                                   \
+    return 0;                                                                           \
+}                                                                                       \
+                                                                                        \
+scope int Name##Prior(const Name* L, Type e, Type* result) {                            \
+    int pos = Name##Locate(L, e);                                                       \
+    if (pos == 0) {                                                                     \
+        return LIST_ERR_NOT_FOUND;                                                      \
+    }                                                                                   \
+    if (pos == 1) {                                                                     \
+        return LIST_ERR_NO_PRIOR;                                                       \
+    }                                                                                   \
+    *result = L->elem[pos - 2];                                                         \
+    return LIST_OK;                                                                     \
+}                                                                                       \
+                                                                                        \
+scope int Name##Next(const Name* L, Type e, Type* result) {                             \
+    int pos = Name##Locate(L, e);                                                       \
+    if (pos == 0) {                                                                     \
+        return LIST_ERR_NOT_FOUND;                                                      \
+    }                                                                                   \
+    if (pos == L->length) {                                                             \
+        return LIST_ERR_NO_NEXT;                                                        \
+    }                                                                                   \
+    *result = L->elem[pos];                                                             \
+    return LIST_OK;                                                                     \
+}
+
+/**
+ * @brief A sequential list of int64_t values.
+ */
+DECLARE_TYPED_LIST(SqListInt64, int64_t)
+
+/**
+ * @brief A sequential list of double values.
+ *
+ * Locate, Prior and Next compare with ==, so NaN is never found.
+ */
+DECLARE_TYPED_LIST(SqListDouble, double)
+
+#endif
@@ -0,0 +1,831 @@
+#define _POSIX_C_SOURCE 200809L
+#include "SqList.h"
+#include "SortedList.h"
+#include "GapList.h"
+#include "SmallList.h"
+#include "ConcurrentList.h"
+#include "ParallelList.h"
+#include "MappedList.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <time.h>
+
+/*
+ * Benchmarks for SqList.
+ *
+ * The first table covers the capacity policy under mixed insert/delete
+ * workloads. Every workload is replayed twice: once against the library, counting how
+ * often the capacity changes (each change is one realloc), and once against a
+ * model of the previous policy, which shrank the list by LISTDECREMENT
+ * whenever it was LISTINCREMENT elements below capacity. Both sides grow the
+ * same way, so the difference in the counts comes from the shrink policy.
+ *
+ * The second table times element scans on lists of 10^3 up to 'maxScanSize'
+ * elements. It compares LocateElem and ListCountElem against the scalar
+ * loops they replaced. The searched value is absent, so every call scans
+ * the whole list.
+ *
+ * The third table times lookups of random present values in a sorted list:
+ * LocateElem (a full scan) against the binary search of SortedLocate.
+ *
+ * The last table partitions 'partitionSize' random ints into odd and even:
+ * the two-pointer loop ChangeNums used to run, the branchless ChangeNums,
+ * and ListPartition / ListStablePartition with the same predicate passed by
+ * pointer.
+ *
+ * The edit table runs 200000 inserts and deletes around a cursor that
+ * wanders through the middle of a list of 'editSize' elements, once on a
+ * SqList and once on a GapList.
+ *
+ * The allocator table creates, fills with 40 elements and destroys
+ * 'shortLists' lists, with element storage from malloc, a ListArena reset
+ * after every 1000 lists, and a ListPool.
+ *
+ * The small-list table builds 'shortLists' lists whose lengths are mostly
+ * below 16 (90% in [0, 16), the rest in [16, 64)), as SqList and as
+ * SmallList. A counting allocator records heap allocations and bytes;
+ * memory per list is the structure plus its heap storage at full length.
+ *
+ * The concurrency table runs 'concurrentOps' operations, split across 1 to
+ * 32 threads, on a list of about 1000 elements: 90% OrderNum at a random
+ * position, 10% alternating inserts and deletes at random positions. It
+ * compares a SqList behind one mutex with a ConcurrentList. Times are wall
+ * clock; on a machine with fewer cores than threads the extra threads only
+ * add contention.
+ *
+ * The parallel table times the bulk operations of ParallelList on a list
+ * of 'parallelSize' random ints against their serial counterparts, using
+ * the shared pool (one thread per online CPU).
+ *
+ * The mapped table builds a list of 'mappedSize' ints and compares how
+ * long it takes to get it back in a new list: parsing a text file of the
+ * values, against reopening a MappedList file with and without checksum
+ * verification. It then checks that a read-only reader still reads its
+ * elements while the writer deletes all but 10 of them, and that the
+ * reader's own changes do not reach the file. The files are written to
+ * the current directory and removed afterwards.
+ *
+ *     cc -O2 -std=c11 -pthread benchmark.c SqList.c SortedList.c GapList.c ListAllocator.c SmallList.c ConcurrentList.c ParallelList.c MappedList.c -o benchmark
+ *     ./benchmark [operations] [maxScanSize] [partitionSize] [editSize] [shortLists] [concurrentOps] [parallelSize] [mappedSize]
+ */
+
+typedef struct {
+    int length;
+    int listsize;
+    long reallocs;
+} CapacityModel;
+
+static int ModelGrow(int listsize) {
+    double want = listsize * (double)LIST_GROWTH_FACTOR;
+    int newsize = want > listsize + LISTINCREMENT ? (int)want : listsize + LISTINCREMENT;
+    return newsize;
+}
+
+static void ModelInsert(CapacityModel* m) {
+    if (m->length >= m->listsize) {
+        m->listsize = ModelGrow(m->listsize);
+        m->reallocs++;
+    }
+    m->length++;
+}
+
+static void ModelDelete(CapacityModel* m) {
+    m->length--;
+    if (m->listsize - LISTDECREMENT >= LIST_INIT_SIZE && m->length <= m->listsize - LISTINCREMENT) {
+        m->listsize -= LISTDECREMENT;
+        m->reallocs++;
+    }
+}
+
+/* A recorded workload: a nonzero entry appends an element, zero removes the last one. */
+typedef struct {
+    unsigned char* insert;
+    long count;
+} Trace;
+
+static void TraceOscillate(Trace* t, long ops) {
+    // Fill, then bounce across the point where the old policy shrinks.
+    long fill = 2000, i = 0;
+    for (; i < fill && i < ops; i++) {
+        t->insert[i] = 1;
+    }
+    for (long k = 0; i < ops; i++, k++) {
+        t->insert[i] = (unsigned char)((k / 12) % 2);
+    }
+    t->count = ops;
+}
+
+static void TraceRandomMix(Trace* t, long ops) {
+    long length = 0;
+    for (long i = 0; i < ops; i++) {
+        int ins = length == 0 || rand() % 100 < 51;
+        t->insert[i] = (unsigned char)ins;
+        length += ins ? 1 : -1;
+    }
+    t->count = ops;
+}
+
+static void TraceGrowDrain(Trace* t, long ops) {
+    // Repeated cycles of growing to a peak and draining back to empty.
+    long i = 0, peak = 5000;
+    while (i < ops) {
+        for (long k = 0; k < peak && i < ops; k++) {
+            t->insert[i++] = 1;
+        }
+        for (long k = 0; k < peak && i < ops; k++) {
+            t->insert[i++] = 0;
+        }
+    }
+    t->count = ops;
+}
+
+static void Run(const char* name, const Trace* t) {
+    SqList L;
+    InitList(&L);
+    int lastsize = L.listsize;
+    long reallocs = 0;
+    clock_t start = clock();
+    for (long i = 0; i < t->count; i++) {
+        if (t->insert[i]) {
+            ListInsert(&L, L.length + 1, (ElemType)i);
+        } else if (L.length > 0) {
+            ListDelete(&L, L.length);
+        }
+        if (L.listsize != lastsize) {
+            reallocs++;
+            lastsize = L.listsize;
+        }
+    }
+    double ms = 1000.0 * (double)(clock() - start) / CLOCKS_PER_SEC;
+    int finalsize = L.listsize;
+    DestroyList(&L);
+
+    CapacityModel old = {0, LIST_INIT_SIZE, 0};
+    for (long i = 0; i < t->count; i++) {
+        if (t->insert[i]) {
+            ModelInsert(&old);
+        } else if (old.length > 0) {
+            ModelDelete(&old);
+        }
+    }
+    printf("%-12s %10ld %14ld %14ld %10d %10.2f\n",
+            name, t->count, old.reallocs, reallocs, finalsize, ms);
+}
+
+/* The linear search LocateElem used before the vectorized kernels. */
+static int ScalarLocate(const SqList* L, ElemType e) {
+    for (int i = 0; i < L->length; i++) {
+        if (L->elem[i] == e) {
+            return i + 1;
+        }
+    }
+    return 0;
+}
+
+static int ScalarCount(const SqList* L, ElemType e) {
+    int count = 0;
+    for (int i = 0; i < L->length; i++) {
+        if (L->elem[i] == e) {
+            count++;
+        }
+    }
+    return count;
+}
+
+static double Seconds(void) {
+    return (double)clock() / CLOCKS_PER_SEC;
+}
+
+static void RunScan(int size) {
+    SqList L;
+    if (InitListWithCapacity(&L, size) != LIST_OK) {
+        fprintf(stderr, "Memory allocation failed\n");
+        return;
+    }
+    for (int i = 0; i < size; i++) {
+        ListAppend(&L, i);
+    }
+    // Roughly 2*10^8 element comparisons per measurement.
+    long reps = 200000000L / size;
+    if (reps < 1) {
+        reps = 1;
+    }
+    volatile long sink = 0;
+    double times[4];
+    for (int which = 0; which < 4; which++) {
+        double start = Seconds();
+        for (long r = 0; r < reps; r++) {
+            ElemType e = -1 - (ElemType)(r & 1);
+            switch (which) {
+            case 0: sink += ScalarLocate(&L, e); break;
+            case 1: sink += LocateElem(&L, e); break;
+            case 2: sink += ScalarCount(&L, e); break;
+            default: sink += ListCountElem(&L, e); break;
+            }
+        }
+        times[which] = (Seconds() - start) * 1e9 / (double)reps;
+    }
+    printf("%10d %14.1f %14.1f %8.2f %14.1f %14.1f %8.2f\n", size,
+            times[0], times[1], times[0] / times[1], times[2], times[3], times[2] / times[3]);
+    DestroyList(&L);
+}
+
+static void RunSorted(int size) {
+    SqList L;
+    if (InitListWithCapacity(&L, size) != LIST_OK) {
+        fprintf(stderr, "Memory allocation failed\n");
+        return;
+    }
+    for (int i = 0; i < size; i++) {
+        ListAppend(&L, 2 * i);
+    }
+    long scanReps = 100000000L / size;
+    long searchReps = 1000000L;
+    if (scanReps < 10) {
+        scanReps = 10;
+    }
+    volatile long sink = 0;
+    unsigned seed = 1;
+    double start = Seconds();
+    for (long r = 0; r < scanReps; r++) {
+        seed = seed * 1103515245u + 12345u;
+        sink += LocateElem(&L, 2 * (int)(seed % (unsigned)size));
+    }
+    double scan = (Seconds() - start) * 1e9 / (double)scanReps;
+    start = Seconds();
+    for (long r = 0; r < searchReps; r++) {
+        seed = seed * 1103515245u + 12345u;
+        sink += SortedLocate(&L, 2 * (int)(seed % (unsigned)size));
+    }
+    double search = (Seconds() - start) * 1e9 / (double)searchReps;
+    printf("%10d %14.1f %14.1f %10.1f\n", size, scan, search, scan / search);
+    DestroyList(&L);
+}
+
+/* The two-pointer partition ChangeNums used before the branchless kernel. */
+static void TwoPointerChangeNums(SqList* L) {
+    int left = 0;
+    int right = L->length - 1;
+    while (left < right) {
+        while (left < right && L->elem[left] % 2 != 0) {
+            left++;
+        }
+        while (left < right && L->elem[right] % 2 == 0) {
+            right--;
+        }
+        if (left < right) {
+            Swap(&L->elem[left], &L->elem[right]);
+        }
+    }
+}
+
+static int IsOddElem(ElemType e) {
+    return e & 1;
+}
+
+static void RunPartition(int size) {
+    SqList L;
+    ElemType* data = (ElemType*)malloc((size_t)size * sizeof(ElemType));
+    if (!data || InitListWithCapacity(&L, size) != LIST_OK) {
+        fprintf(stderr, "Memory allocation failed\n");
+        free(data);
+        return;
+    }
+    unsigned seed = 7;
+    for (int i = 0; i < size; i++) {
+        seed = seed * 1103515245u + 12345u;
+        data[i] = (ElemType)(seed >> 8);
+    }
+    static const char* names[] = { "two_pointer", "ChangeNums", "ListPartition", "ListStablePartition" };
+    double base = 0;
+    for (int which = 0; which < 4; which++) {
+        ClearList(&L);
+        ListAppendRange(&L, data, size);
+        double start = Seconds();
+        switch (which) {
+        case 0: TwoPointerChangeNums(&L); break;
+        case 1: ChangeNums(&L); break;
+        case 2: ListPartition(&L, IsOddElem); break;
+        default: ListStablePartition(&L, IsOddElem); break;
+        }
+        double ms = (Seconds() - start) * 1e3;
+        if (which == 0) {
+            base = ms;
+        }
+        printf("%-20s %10d %10.2f %8.2f\n", names[which], size, ms, base / ms);
+    }
+    DestroyList(&L);
+    free(data);
+}
+
+static void RunCursorEdits(int size) {
+    SqList L;
+    GapList G;
+    if (InitListWithCapacity(&L, size) != LIST_OK || InitGapList(&G, size) != LIST_OK) {
+        fprintf(stderr, "Memory allocation failed\n");
+        DestroyList(&L);
+        return;
+    }
+    for (int i = 0; i < size; i++) {
+        ListAppend(&L, i);
+        GapListInsert(&G, i + 1, i);
+    }
+    const long edits = 200000;
+    double times[2];
+    for (int which = 0; which < 2; which++) {
+        unsigned seed = 3;
+        int cursor = size / 2 + 1;
+        double start = Seconds();
+        for (long r = 0; r < edits; r++) {
+            seed = seed * 1103515245u + 12345u;
+            // Step the cursor by -8..7 positions, then insert or delete there.
+            cursor += (int)((seed >> 16) % 16) - 8;
+            if (cursor < 1) {
+                cursor = 1;
+            }
+            if (cursor > size) {
+                cursor = size;
+            }
+            if (r & 1) {
+                if (which == 0) {
+                    ListDelete(&L, cursor);
+                }
+                else {
+                    GapListDelete(&G, cursor);
+                }
+            }
+            else if (which == 0) {
+                ListInsert(&L, cursor, (ElemType)r);
+            }
+            else {
+                GapListInsert(&G, cursor, (ElemType)r);
+            }
+        }
+        times[which] = (Seconds() - start) * 1e9 / (double)edits;
+    }
+    printf("%10d %14.1f %14.1f %10.1f\n", size, times[0], times[1], times[0] / times[1]);
+    DestroyList(&L);
+    DestroyGapList(&G);
+}
+
+static void RunShortLived(long lists) {
+    ListArena arena;
+    ListPool pool;
+    InitListArena(&arena, 0);
+    InitListPool(&pool);
+    static const char* names[] = { "malloc", "ListArena", "ListPool" };
+    const ListAllocator* allocators[] = { NULL, &arena.allocator, &pool.allocator };
+    double base = 0;
+    for (int which = 0; which < 3; which++) {
+        volatile long sink = 0;
+        double start = Seconds();
+        for (long r = 0; r < lists; r++) {
+            SqList L;
+            if (InitListWithAllocator(&L, 4, allocators[which]) != LIST_OK) {
+                fprintf(stderr, "Memory allocation failed\n");
+                break;
+            }
+            for (int i = 0; i < 40; i++) {
+                ListAppend(&L, i);
+            }
+            sink += L.elem[L.length - 1];
+            DestroyList(&L);
+            if (which == 1 && r % 1000 == 999) {
+                ResetListArena(&arena);
+            }
+        }
+        double ns = (Seconds() - start) * 1e9 / (double)lists;
+        if (which == 0) {
+            base = ns;
+        }
+        printf("%-12s %10ld %14.1f %8.2f\n", names[which], lists, ns, base / ns);
+    }
+    DestroyListArena(&arena);
+    DestroyListPool(&pool);
+}
+
+typedef struct {
+    long allocations; ///< Calls to allocate, plus reallocate calls that moved to a new size
+    size_t live; ///< Bytes currently allocated
+} CountingHeap;
+
+static void* CountingAllocate(void* ctx, size_t size) {
+    CountingHeap* heap = (CountingHeap*)ctx;
+    heap->allocations++;
+    heap->live += size;
+    return malloc(size);
+}
+
+static void* CountingReallocate(void* ctx, void* ptr, size_t oldSize, size_t newSize) {
+    CountingHeap* heap = (CountingHeap*)ctx;
+    heap->allocations++;
+    heap->live += newSize - oldSize;
+    return realloc(ptr, newSize);
+}
+
+static void CountingRelease(void* ctx, void* ptr, size_t size) {
+    CountingHeap* heap = (CountingHeap*)ctx;
+    heap->live -= size;
+    free(ptr);
+}
+
+static void RunSmallLists(long lists) {
+    CountingHeap counts[2] = { { 0, 0 }, { 0, 0 } };
+    static const char* names[] = { "SqList", "SmallList" };
+    for (int which = 0; which < 2; which++) {
+        ListAllocator counting = { CountingAllocate, CountingReallocate, CountingRelease, &counts[which] };
+        unsigned seed = 5;
+        double bytes = 0;
+        double start = Seconds();
+        for (long r = 0; r < lists; r++) {
+            seed = seed * 1103515245u + 12345u;
+            unsigned pick = (seed >> 16) % 100;
+            int length = pick < 90 ? (int)(pick % 16) : 16 + (int)(pick % 48);
+            if (which == 0) {
+                SqList L;
+                InitListWithAllocator(&L, LIST_INIT_SIZE, &counting);
+                for (int i = 0; i < length; i++) {
+                    ListAppend(&L, i);
+                }
+                bytes += (double)(sizeof(SqList) + counts[0].live);
+                DestroyList(&L);
+            }
+            else {
+                SmallList S;
+                InitSmallList(&S, &counting);
+                for (int i = 0; i < length; i++) {
+                    SmallListAppend(&S, i);
+                }
+                bytes += (double)(sizeof(SmallList) + counts[1].live);
+                DestroySmallList(&S);
+            }
+        }
+        double ns = (Seconds() - start) * 1e9 / (double)lists;
+        printf("%-12s %10ld %16.3f %16.1f %12.1f\n", names[which], lists,
+                (double)counts[which].allocations / (double)lists, bytes / (double)lists, ns);
+    }
+}
+
+#define MIXED_LIST_SIZE 1000 ///< Starting length of the list in the concurrency table
+
+typedef struct {
+    SqList* list; ///< List behind 'lock', or NULL to use 'concurrent'
+    pthread_mutex_t* lock;
+    ConcurrentList* concurrent;
+    long ops; ///< Operations for this thread
+    unsigned seed;
+    long long checksum; ///< Sum of values read, so the reads are not optimized away
+} MixedWorker;
+
+static double WallSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static void* RunMixedWorker(void* arg) {
+    MixedWorker* w = (MixedWorker*)arg;
+    int reader = w->list == NULL ? ConcurrentListRegister(w->concurrent) : 0;
+    int inserting = 1;
+    for (long op = 0; op < w->ops; op++) {
+        w->seed = w->seed * 1103515245u + 12345u;
+        unsigned r = w->seed >> 8;
+        ElemType e = 0;
+        if (r % 10 != 0) {
+            int i = 1 + (int)((r / 10) % MIXED_LIST_SIZE);
+            if (w->list != NULL) {
+                pthread_mutex_lock(w->lock);
+                if (i <= w->list->length) {
+                    OrderNum(w->list, i, &e);
+                }
+                pthread_mutex_unlock(w->lock);
+            }
+            else {
+                ConcurrentOrderNum(w->concurrent, reader, i, &e);
+            }
+            w->checksum += e;
+            continue;
+        }
+        // Positions past the end are rejected, which keeps the length near MIXED_LIST_SIZE.
+        int i = 1 + (int)((r / 10) % MIXED_LIST_SIZE);
+        if (w->list != NULL) {
+            pthread_mutex_lock(w->lock);
+            if (inserting) {
+                ListInsert(w->list, i, (ElemType)r);
+            }
+            else {
+                ListDelete(w->list, i);
+            }
+            pthread_mutex_unlock(w->lock);
+        }
+        else if (inserting) {
+            ConcurrentListInsert(w->concurrent, i, (ElemType)r);
+        }
+        else {
+            ConcurrentListDelete(w->concurrent, i);
+        }
+        inserting = !inserting;
+    }
+    if (w->list == NULL) {
+        ConcurrentListUnregister(w->concurrent, reader);
+    }
+    return NULL;
+}
+
+static void RunMixed(long ops) {
+    static const int threadCounts[] = { 1, 2, 4, 8, 16, 32 };
+    for (size_t t = 0; t < sizeof(threadCounts) / sizeof(threadCounts[0]); t++) {
+        int threads = threadCounts[t];
+        double mops[2];
+        for (int which = 0; which < 2; which++) {
+            SqList L;
+            ConcurrentList C;
+            pthread_mutex_t lock;
+            pthread_mutex_init(&lock, NULL);
+            InitList(&L);
+            InitConcurrentList(&C, MIXED_LIST_SIZE * 2);
+            for (int i = 0; i < MIXED_LIST_SIZE; i++) {
+                ListAppend(&L, i);
+                ConcurrentListAppend(&C, i);
+            }
+            MixedWorker workers[32];
+            pthread_t ids[32];
+            for (int k = 0; k < threads; k++) {
+                workers[k].list = which == 0 ? &L : NULL;
+                workers[k].lock = &lock;
+                workers[k].concurrent = &C;
+                workers[k].ops = ops / threads;
+                workers[k].seed = 17u + (unsigned)k;
+                workers[k].checksum = 0;
+            }
+            double start = WallSeconds();
+            for (int k = 0; k < threads; k++) {
+                pthread_create(&ids[k], NULL, RunMixedWorker, &workers[k]);
+            }
+            for (int k = 0; k < threads; k++) {
+                pthread_join(ids[k], NULL);
+            }
+            double elapsed = WallSeconds() - start;
+            mops[which] = (double)(ops / threads * threads) / elapsed / 1e6;
+            DestroyConcurrentList(&C);
+            DestroyList(&L);
+            pthread_mutex_destroy(&lock);
+        }
+        printf("%8d %10ld %16.2f %16.2f %8.2fx\n", threads, ops, mops[0], mops[1], mops[1] / mops[0]);
+    }
+}
+
+static ElemType Increment(ElemType e) {
+    return e + 1;
+}
+
+static void PrintParallel(const char* name, double serial, double parallel) {
+    printf("%-12s %12.2f %12.2f %8.2fx\n", name, serial * 1e3, parallel * 1e3, serial / parallel);
+}
+
+/**
+ * Runs a job on freshly started pools, before the workers have had time to
+ * park. A worker that misses the first job leaves the call waiting forever.
+ */
+static int CheckPoolStartup(void) {
+    SqList L;
+    InitList(&L);
+    for (int i = 0; i < 100; i++) {
+        ListAppend(&L, i);
+    }
+    int ok = 1;
+    for (int round = 0; round < 100 && ok; round++) {
+        ListThreadPool P;
+        if (InitListThreadPool(&P, 4, 1) != LIST_OK) {
+            break;
+        }
+        ok = ParallelListSum(&P, &L) == 4950;
+        DestroyListThreadPool(&P);
+    }
+    DestroyList(&L);
+    return ok;
+}
+
+static void RunParallel(int size) {
+    SqList L;
+    if (InitListWithCapacity(&L, size) != LIST_OK) {
+        fprintf(stderr, "Memory allocation failed\n");
+        return;
+    }
+    for (int i = 0; i < size; i++) {
+        ListAppend(&L, rand() % 1000000);
+    }
+    ListThreadPool* pool = ListSharedThreadPool();
+    printf("threads: %d, pool startup check: %s\n", pool != NULL ? pool->threads : 1,
+            CheckPoolStartup() ? "ok" : "FAILED");
+    volatile long long sink = 0;
+
+    double start = WallSeconds();
+    sink += LocateElem(&L, -1);
+    double serial = WallSeconds() - start;
+    start = WallSeconds();
+    sink += ParallelLocateElem(pool, &L, -1);
+    PrintParallel("locate", serial, WallSeconds() - start);
+
+    start = WallSeconds();
+    sink += ListCountElem(&L, 42);
+    serial = WallSeconds() - start;
+    start = WallSeconds();
+    sink += ParallelCountElem(pool, &L, 42);
+    PrintParallel("count", serial, WallSeconds() - start);
+
+    start = WallSeconds();
+    long long sum = 0;
+    ElemType lowest = L.elem[0];
+    ElemType highest = L.elem[0];
+    for (int i = 0; i < L.length; i++) {
+        sum += L.elem[i];
+        lowest = L.elem[i] < lowest ? L.elem[i] : lowest;
+        highest = L.elem[i] > highest ? L.elem[i] : highest;
+    }
+    sink += sum + lowest + highest;
+    serial = WallSeconds() - start;
+    start = WallSeconds();
+    sink += ParallelListSum(pool, &L);
+    PrintParallel("sum", serial, WallSeconds() - start);
+
+    start = WallSeconds();
+    for (int i = 0; i < L.length; i++) {
+        L.elem[i] = Increment(L.elem[i]);
+    }
+    serial = WallSeconds() - start;
+    start = WallSeconds();
+    ParallelListMap(pool, &L, Increment);
+    PrintParallel("map", serial, WallSeconds() - start);
+
+    start = WallSeconds();
+    ListStablePartition(&L, IsOddElem);
+    serial = WallSeconds() - start;
+    for (int i = 0; i < L.length; i++) {
+        L.elem[i] = rand() % 1000000;
+    }
+    start = WallSeconds();
+    ParallelChangeNums(pool, &L);
+    PrintParallel("change_nums", serial, WallSeconds() - start);
+    (void)sink;
+    DestroyList(&L);
+}
+
+// A read-only reader must survive its writer shrinking the list, and its own writes must stay private
+static int CheckSharedReader(const char* path, int size) {
+    MappedList W;
+    MappedList R;
+    if (CreateMappedList(&W, path, LIST_INIT_SIZE) != LIST_OK) {
+        return 0;
+    }
+    for (int i = 0; i < size; i++) {
+        ListAppend(&W.list, i);
+    }
+    SyncMappedList(&W);
+    if (OpenMappedList(&R, path, MAPPED_LIST_READONLY | MAPPED_LIST_VERIFY) != LIST_OK) {
+        CloseMappedList(&W);
+        return 0;
+    }
+    ListDeleteRange(&W.list, 11, W.list.length + 1);
+    ElemType last = -1;
+    int ok = OrderNum(&R.list, size, &last) == LIST_OK && last == size - 1;
+    ok = ok && ListDeleteRange(&R.list, 1, R.list.length + 1) == LIST_OK && ListAppend(&R.list, -1) == LIST_OK;
+    ElemType first = -1;
+    ok = ok && OrderNum(&W.list, 1, &first) == LIST_OK && first == 0;
+    CloseMappedList(&R);
+    CloseMappedList(&W);
+    return ok;
+}
+
+static void RunMapped(int size) {
+    static const char* textPath = "benchmark_list.txt";
+    static const char* mappedPath = "benchmark_list.sqlist";
+    FILE* text = fopen(textPath, "w");
+    MappedList M;
+    if (text == NULL || CreateMappedList(&M, mappedPath, LIST_INIT_SIZE) != LIST_OK) {
+        fprintf(stderr, "Could not create the benchmark files\n");
+        if (text != NULL) {
+            fclose(text);
+        }
+        return;
+    }
+    double start = WallSeconds();
+    for (int i = 0; i < size; i++) {
+        ListAppend(&M.list, rand());
+    }
+    CloseMappedList(&M);
+    printf("%-16s %10d %12.2f\n", "build_mapped", size, (WallSeconds() - start) * 1e3);
+    for (int i = 0; i < size; i++) {
+        fprintf(text, "%d\n", rand());
+    }
+    fclose(text);
+
+    start = WallSeconds();
+    SqList L;
+    InitList(&L);
+    text = fopen(textPath, "r");
+    ElemType e;
+    while (text != NULL && fscanf(text, "%d", &e) == 1) {
+        ListAppend(&L, e);
+    }
+    if (text != NULL) {
+        fclose(text);
+    }
+    printf("%-16s %10d %12.2f\n", "reload_text", L.length, (WallSeconds() - start) * 1e3);
+    DestroyList(&L);
+
+    static const char* names[] = { "reopen", "reopen_readonly", "reopen_verify" };
+    static const int flags[] = { 0, MAPPED_LIST_READONLY, MAPPED_LIST_VERIFY };
+    for (int k = 0; k < 3; k++) {
+        start = WallSeconds();
+        int status = OpenMappedList(&M, mappedPath, flags[k]);
+        double elapsed = WallSeconds() - start;
+        if (status != LIST_OK) {
+            printf("%-16s %s\n", names[k], ListStatusString(status));
+            continue;
+        }
+        printf("%-16s %10d %12.3f\n", names[k], M.list.length, elapsed * 1e3);
+        CloseMappedList(&M);
+    }
+    printf("shared reader check: %s\n", CheckSharedReader(mappedPath, size) ? "ok" : "FAILED");
+    remove(textPath);
+    remove(mappedPath);
+}
+
+int main(int argc, char* argv[]) {
+    long ops = argc > 1 ? atol(argv[1]) : 1000000;
+    if (ops <= 0) {
+        ops = 1000000;
+    }
+    long maxScanSize = argc > 2 ? atol(argv[2]) : 10000000;
+    long partitionSize = argc > 3 ? atol(argv[3]) : 10000000;
+    long editSize = argc > 4 ? atol(argv[4]) : 1000000;
+    long shortLists = argc > 5 ? atol(argv[5]) : 1000000;
+    long concurrentOps = argc > 6 ? atol(argv[6]) : 4000000;
+    long parallelSize = argc > 7 ? atol(argv[7]) : 10000000;
+    long mappedSize = argc > 8 ? atol(argv[8]) : 10000000;
+    Trace t;
+    t.insert = (unsigned char*)malloc((size_t)ops);
+    if (!t.insert) {
+        fprintf(stderr, "Memory allocation failed\n");
+        return 1;
+    }
+    srand(12345);
+    printf("%-12s %10s %14s %14s %10s %10s\n",
+            "workload", "ops", "reallocs_old", "reallocs_new", "capacity", "ms");
+    TraceOscillate(&t, ops);
+    Run("oscillate", &t);
+    TraceRandomMix(&t, ops);
+    Run("random_mix", &t);
+    TraceGrowDrain(&t, ops);
+    Run("grow_drain", &t);
+    free(t.insert);
+
+    printf("\n%10s %14s %14s %8s %14s %14s %8s\n", "size",
+            "locate_old_ns", "locate_new_ns", "speedup", "count_old_ns", "count_new_ns", "speedup");
+    for (long size = 1000; size <= maxScanSize; size *= 10) {
+        RunScan((int)size);
+    }
+
+    printf("\n%10s %14s %14s %10s\n", "size", "locate_ns", "sorted_ns", "speedup");
+    for (long size = 1000; size <= maxScanSize; size *= 10) {
+        RunSorted((int)size);
+    }
+
+    printf("\n%-20s %10s %10s %8s\n", "partition", "size", "ms", "speedup");
+    if (partitionSize > 0) {
+        RunPartition((int)partitionSize);
+    }
+
+    printf("\n%10s %14s %14s %10s\n", "edit_size", "sqlist_ns", "gaplist_ns", "speedup");
+    if (editSize > 0) {
+        RunCursorEdits((int)editSize);
+    }
+
+    printf("\n%-12s %10s %14s %8s\n", "allocator", "lists", "ns_per_list", "speedup");
+    if (shortLists > 0) {
+        RunShortLived(shortLists);
+    }
+
+    printf("\n%-12s %10s %16s %16s %12s\n", "small_lists", "lists", "allocs_per_list", "bytes_per_list", "ns_per_list");
+    if (shortLists > 0) {
+        RunSmallLists(shortLists);
+    }
+
+    printf("\n%8s %10s %16s %16s %9s\n", "threads", "ops", "mutex_mops", "concurrent_mops", "speedup");
+    if (concurrentOps > 0) {
+        RunMixed(concurrentOps);
+    }
+
+    printf("\n%-12s %12s %12s %9s\n", "parallel", "serial_ms", "parallel_ms", "speedup");
+    if (parallelSize > 0) {
+        RunParallel((int)parallelSize);
+    }
+
+    printf("\n%-16s %10s %12s\n", "mapped", "elements", "ms");
+    if (mappedSize > 0) {
+        RunMapped((int)mappedSize);
+    }
+    return 0;
+}
\ No newline at end of file
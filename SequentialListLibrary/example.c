@@ -24,14 +24,28 @@
  *
  * 5. Reorder the list with odd numbers before even numbers.
  *    Insert elements 7 and 8, then reorder.
- *    Expected list after reordering: 15 7 5 10 20 8
+ *    Expected list after reordering: 15 7 8 20 10
  */
 
+/*
+ * The list functions are silent by default; this hook prints their
+ * diagnostics so the example shows when the list grows, is cleared, etc.
+ */
+static void PrintDiagnostic(int status, const char* message) {
+    if (status == LIST_OK) {
+        printf("%s\n", message);
+    } else {
+        printf("%s (%s)\n", message, ListStatusString(status));
+    }
+}
+
 int main() {
     SqList list;
     ElemType result;
     int status;
 
+    SetListLogHook(PrintDiagnostic);
+
     // Initialize the list
     printf("Initializing the list...\n");
     InitList(&list);
@@ -40,19 +54,19 @@ int main() {
     // Test inserting elements
     printf("\nTesting inserting elements...\n");
     status = ListInsert(&list, 1, 10);
-    if (status == FALSE) {
+    if (status != LIST_OK) {
         printf("Failed to insert element 10 at position 1\n");
     }
     status = ListInsert(&list, 2, 15);
-    if (status == FALSE) {
+    if (status != LIST_OK) {
         printf("Failed to insert element 15 at position 2\n");
     }
     status = ListInsert(&list, 3, 20);
-    if (status == FALSE) {
+    if (status != LIST_OK) {
         printf("Failed to insert element 20 at position 3\n");
     }
     status = ListInsert(&list, 2, 5);
-    if (status == FALSE) {
+    if (status != LIST_OK) {
         printf("Failed to insert element 5 at position 2\n");
     }
     PrintList(&list);
@@ -60,7 +74,7 @@ int main() {
     // Test deleting elements
     printf("\nTesting deleting elements...\n");
     status = ListDelete(&list, 2);
-    if (status == FALSE) {
+    if (status != LIST_OK) {
         printf("Failed to delete element at position 2\n");
     }
     PrintList(&list);
@@ -68,7 +82,7 @@ int main() {
     // Test locating an element
     printf("\nTesting locating an element...\n");
     int pos = LocateElem(&list, 15);
-    if (pos != FALSE) {
+    if (pos != 0) {
         printf("The position of element 15 is: %d\n", pos);
     } else {
         printf("Element 15 not found\n");
@@ -76,7 +90,7 @@ int main() {
 
     // Test finding predecessor
     printf("\nTesting finding predecessor...\n");
-    if (PriorElem(&list, 15, &result) == TRUE) {
+    if (PriorElem(&list, 15, &result) == LIST_OK) {
         printf("The predecessor of element 15 is: %d\n", result);
     } else {
         printf("No predecessor found for element 15\n");
@@ -84,7 +98,7 @@ int main() {
 
     // Test finding successor
     printf("\nTesting finding successor...\n");
-    if (NextElem(&list, 15, &result) == TRUE) {
+    if (NextElem(&list, 15, &result) == LIST_OK) {
         printf("The successor of element 15 is: %d\n", result);
     } else {
         printf("No successor found for element 15\n");
@@ -93,7 +107,7 @@ int main() {
     // Test expanding the list
     printf("\nTesting expanding the list...\n");
     status = ExpandList(&list);
-    if (status == FALSE) {
+    if (status != LIST_OK) {
         printf("Failed to expand the list\n");
     } else {
         printf("List expanded successfully\n");